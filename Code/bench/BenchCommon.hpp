@@ -0,0 +1,43 @@
+// BenchCommon.hpp
+#ifndef BENCH_COMMON_HPP
+#define BENCH_COMMON_HPP
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+// 基准程序共用的计时和统计工具
+
+class Stopwatch {
+private:
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+public:
+    void restart() { begin = std::chrono::steady_clock::now(); }
+
+    double elapsedMs() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    double elapsedUs() const { return elapsedMs() * 1000.0; }
+};
+
+// 第 p 百分位（0-100），会对 samples 排序
+inline double percentile(std::vector<double>& samples, double p) {
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(samples.size() - 1) + 0.5);
+    return samples[std::min(index, samples.size() - 1)];
+}
+
+// 命令行第 index 个参数作为整数，缺省时返回 fallback
+inline long argOr(int argc, char** argv, int index, long fallback) {
+    return argc > index ? std::atol(argv[index]) : fallback;
+}
+
+#endif // BENCH_COMMON_HPP
@@ -0,0 +1,119 @@
+// bench_allocation.cpp
+// 批量审批：AllocationEngine 与“按优先级排序后逐个请求线性扫描空闲资源”的对比，
+// 以及带价格上限时的耗时（容量满足要求的小资源大多超价）
+// 用法: bench_allocation [请求数=10000] [资源数=1000]
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "../include/Allocation.hpp"
+#include "BenchCommon.hpp"
+
+using Clock = std::chrono::system_clock;
+
+struct Workload {
+    ResourceCollection collection;
+    std::vector<RentalRequest> requests;
+    std::vector<AllocationRequest> entries;
+};
+
+// 一半 CPU（1-64 核）一半 GPU（8-80G），rateCap > 0 时每个请求都带价格上限
+void buildWorkload(Workload& work, size_t requestCount, size_t resourceCount, double rateCap, unsigned seed) {
+    std::mt19937 rng(seed);
+    Clock::time_point t0 = Clock::now();
+    for (size_t i = 0; i < resourceCount; ++i) {
+        if (i % 2) {
+            work.collection.addResource(std::make_shared<CPUResource>("c" + std::to_string(i), "cpu", 1 + rng() % 10,
+                                                                      1 << (rng() % 7), 3.0));
+        } else {
+            work.collection.addResource(std::make_shared<GPUResource>("g" + std::to_string(i), "gpu", 5 + rng() % 20,
+                                                                      4000, 8 * (1 + rng() % 10)));
+        }
+    }
+    work.requests.reserve(requestCount);
+    for (size_t i = 0; i < requestCount; ++i) {
+        work.requests.emplace_back("r" + std::to_string(i), "u" + std::to_string(i % 3000), "", t0,
+                                   std::chrono::hours(2));
+        work.requests.back().requestTime = t0 + std::chrono::seconds(rng() % 100000);
+        bool cpu = i % 2;
+        int capacity = cpu ? 1 << (rng() % 7) : 8 * (1 + static_cast<int>(rng() % 10));
+        work.entries.push_back(AllocationRequest{&work.requests.back(), i % 5 == 0 ? UserRole::TEACHER : UserRole::STUDENT,
+                                                 ResourceDemand{cpu ? ResourceType::CPU : ResourceType::GPU, capacity,
+                                                                rateCap}});
+    }
+}
+
+// 对照：排序后每个请求线性扫描同类型的空闲资源，取容量最小、同容量最便宜且不超价的
+size_t naiveApprove(Workload& work) {
+    std::vector<uint32_t> order(work.entries.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    const auto& entries = work.entries;
+    std::stable_sort(order.begin(), order.end(), [&entries](uint32_t a, uint32_t b) {
+        uint8_t pa = kApprovalPriority[static_cast<size_t>(entries[a].role)];
+        uint8_t pb = kApprovalPriority[static_cast<size_t>(entries[b].role)];
+        if (pa != pb) return pa < pb;
+        return entries[a].request->requestTime < entries[b].request->requestTime;
+    });
+    size_t approved = 0;
+    for (uint32_t index : order) {
+        const ResourceDemand& demand = entries[index].demand;
+        std::shared_ptr<Resource> best;
+        int bestCapacity = 0;
+        for (const auto& resource : work.collection.getAvailableResourcesByType(demand.type)) {
+            int capacity = resourceCapacity(*resource);
+            if (capacity < demand.minCapacity ||
+                (demand.maxHourlyRate > 0 && resource->getHourlyRate() > demand.maxHourlyRate)) {
+                continue;
+            }
+            if (!best || capacity < bestCapacity ||
+                (capacity == bestCapacity && resource->getHourlyRate() < best->getHourlyRate())) {
+                best = resource;
+                bestCapacity = capacity;
+            }
+        }
+        if (best) {
+            best->setStatus(ResourceStatus::IN_USE);
+            entries[index].request->status = RentalStatus::APPROVED;
+            ++approved;
+        }
+    }
+    return approved;
+}
+
+int main(int argc, char** argv) {
+    const size_t requestCount = static_cast<size_t>(argOr(argc, argv, 1, 10000));
+    const size_t resourceCount = static_cast<size_t>(argOr(argc, argv, 2, 1000));
+
+    bool ok = true;
+    for (double rateCap : {0.0, 6.0}) {
+        for (unsigned round = 0; round < 3; ++round) {
+            Workload batch;
+            buildWorkload(batch, requestCount, resourceCount, rateCap, round + 1);
+            Stopwatch watch;
+            AllocationPlan plan = AllocationEngine::approveAll(batch.collection, batch.entries);
+            double batchMs = watch.elapsedMs();
+
+            Workload naive;
+            buildWorkload(naive, requestCount, resourceCount, rateCap, round + 1);
+            watch.restart();
+            size_t naiveApproved = naiveApprove(naive);
+            double naiveMs = watch.elapsedMs();
+
+            if (rateCap > 0) {
+                std::cout << "价格上限 " << rateCap;
+            } else {
+                std::cout << "不限价";
+            }
+            std::cout << ", " << requestCount << " 个请求 / " << resourceCount << " 个资源: 批量 " << batchMs
+                      << " ms (批准 " << plan.assignments.size() << "), 线性扫描 " << naiveMs << " ms (批准 "
+                      << naiveApproved << ")\n";
+            ok = ok && plan.assignments.size() == naiveApproved;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+// bench_balance_ledger.cpp
+// 多线程随机存取款、预留/扣款/退还：无锁 BalanceAccount 与互斥量账户的吞吐量，并校验余额守恒
+// 用法: bench_balance_ledger [线程数=8] [每线程操作数=2000000]
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../include/BalanceLedger.hpp"
+#include "BenchCommon.hpp"
+
+// 对照：同样的接口，用互斥量保护
+class MutexAccount {
+private:
+    std::mutex mutex;
+    Money available;
+    Money reserved = 0;
+
+public:
+    explicit MutexAccount(Money initial) : available(initial) {}
+
+    bool deposit(Money amount) {
+        std::lock_guard<std::mutex> lock(mutex);
+        available += amount;
+        return true;
+    }
+    bool withdraw(Money amount) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (available < amount) return false;
+        available -= amount;
+        return true;
+    }
+    bool reserve(Money amount) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (available < amount) return false;
+        available -= amount;
+        reserved += amount;
+        return true;
+    }
+    bool commit(Money amount) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (reserved < amount) return false;
+        reserved -= amount;
+        return true;
+    }
+    bool refund(Money amount) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (reserved < amount) return false;
+        reserved -= amount;
+        available += amount;
+        return true;
+    }
+    Money getAvailable() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return available;
+    }
+    Money getReserved() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return reserved;
+    }
+};
+
+struct RunResult {
+    double mops = 0;
+    bool conserved = false;
+};
+
+// 各线程随机选账户执行操作；结束后检查 总余额 = 初始 + 存入 - 取出 - 扣款，且没有剩余预留、没有负余额
+template <typename Account>
+RunResult run(std::vector<std::unique_ptr<Account>>& accounts, Money initial, size_t threads, size_t ops) {
+    std::vector<Money> inflow(threads, 0), outflow(threads, 0);
+    std::vector<std::thread> workers;
+    Stopwatch watch;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937 rng(static_cast<unsigned>(t));
+            for (size_t k = 0; k < ops; ++k) {
+                Account& account = *accounts[rng() % accounts.size()];
+                Money amount = rng() % 500;
+                switch (rng() % 4) {
+                    case 0:
+                        account.deposit(amount);
+                        inflow[t] += amount;
+                        break;
+                    case 1:
+                        if (account.withdraw(amount)) outflow[t] += amount;
+                        break;
+                    case 2:
+                        if (account.reserve(amount)) {
+                            Money charged = amount / 2;
+                            account.commit(charged);
+                            account.refund(amount - charged);
+                            outflow[t] += charged;
+                        }
+                        break;
+                    default:
+                        if (account.reserve(amount)) account.refund(amount);
+                        break;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    RunResult result;
+    result.mops = static_cast<double>(threads * ops) / watch.elapsedMs() / 1000.0;
+
+    Money expected = initial * static_cast<Money>(accounts.size());
+    for (size_t t = 0; t < threads; ++t) {
+        expected += inflow[t] - outflow[t];
+    }
+    Money total = 0;
+    result.conserved = true;
+    for (auto& account : accounts) {
+        Money available = account->getAvailable();
+        result.conserved = result.conserved && available >= 0 && account->getReserved() == 0;
+        total += available;
+    }
+    result.conserved = result.conserved && total == expected;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    const size_t threads = static_cast<size_t>(argOr(argc, argv, 1, 8));
+    const size_t ops = static_cast<size_t>(argOr(argc, argv, 2, 2000000));
+    const Money initial = 100000;
+
+    bool ok = true;
+    for (size_t count : {size_t(1), size_t(1024)}) {
+        std::vector<std::unique_ptr<BalanceAccount>> lockFree;
+        std::vector<std::unique_ptr<MutexAccount>> locked;
+        for (size_t i = 0; i < count; ++i) {
+            lockFree.push_back(std::make_unique<BalanceAccount>(initial));
+            locked.push_back(std::make_unique<MutexAccount>(initial));
+        }
+        RunResult a = run(lockFree, initial, threads, ops);
+        RunResult b = run(locked, initial, threads, ops);
+        std::cout << threads << " 线程, " << count << " 个账户: 无锁 " << a.mops << " Mops/s, 互斥量 " << b.mops
+                  << " Mops/s" << (a.conserved && b.conserved ? ", 余额守恒" : ", 余额不守恒!") << "\n";
+        ok = ok && a.conserved && b.conserved;
+    }
+    return ok ? 0 : 1;
+}
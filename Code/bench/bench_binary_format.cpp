@@ -0,0 +1,72 @@
+// bench_binary_format.cpp
+// resources.dat 的 v2 二进制格式与旧格式（逐条 serialize）的保存、加载耗时
+// 用法: bench_binary_format [资源数=1000000]
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <cstdio>
+
+#include "../include/Resource.hpp"
+#include "BenchCommon.hpp"
+
+int main(int argc, char** argv) {
+    const size_t count = static_cast<size_t>(argOr(argc, argv, 1, 1000000));
+    const std::string legacyFile = "bench_resources_legacy.dat";
+    const std::string v2File = "bench_resources_v2.dat";
+
+    ResourceCollection collection;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 2) {
+            collection.addResource(
+                std::make_shared<CPUResource>("CPU" + std::to_string(i), "Intel Xeon Gold 6348", 3.5, 28, 2.6));
+        } else {
+            collection.addResource(
+                std::make_shared<GPUResource>("GPU" + std::to_string(i), "NVIDIA A100 80GB", 8.0, 6912, 80));
+        }
+    }
+
+    // 旧格式：记录数 + 每条的类型和 serialize 输出
+    Stopwatch watch;
+    {
+        std::ofstream file(legacyFile, std::ios::binary);
+        size_t size = collection.size();
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        collection.forEachResource([&file](const Resource& resource) {
+            ResourceType type = resource.getResourceType();
+            file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+            resource.serialize(file);
+        });
+    }
+    double legacySave = watch.elapsedMs();
+
+    watch.restart();
+    collection.saveToFile(v2File);
+    double v2Save = watch.elapsedMs();
+
+    watch.restart();
+    size_t legacyCount;
+    {
+        ResourceCollection loaded;
+        loaded.loadFromFile(legacyFile);
+        legacyCount = loaded.size();
+    }
+    double legacyLoad = watch.elapsedMs();
+
+    watch.restart();
+    size_t v2Count;
+    {
+        ResourceCollection loaded;
+        loaded.loadFromFile(v2File);
+        v2Count = loaded.size();
+    }
+    double v2Load = watch.elapsedMs();
+
+    std::remove(legacyFile.c_str());
+    std::remove(v2File.c_str());
+
+    std::cout << count << " 个资源\n";
+    std::cout << "保存: 旧格式 " << legacySave << " ms, v2 " << v2Save << " ms\n";
+    std::cout << "加载（含建索引）: 旧格式 " << legacyLoad << " ms, v2 " << v2Load << " ms\n";
+    return legacyCount == count && v2Count == count ? 0 : 1;
+}
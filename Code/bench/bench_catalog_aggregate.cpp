@@ -0,0 +1,79 @@
+// bench_catalog_aggregate.cpp
+// 聚合查询：列式目录 ResourceCatalog 的顺序循环与遍历 ResourceCollection 中多态资源对象的对比
+// 统计空闲GPU显存总量、CPU平均每小时价格、空闲CPU核心总数；另测由集合构建目录快照的耗时
+// 用法: bench_catalog_aggregate [资源数=50000] [重复次数=200]
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../include/ResourceCatalog.hpp"
+#include "BenchCommon.hpp"
+
+int main(int argc, char** argv) {
+    const size_t count = static_cast<size_t>(argOr(argc, argv, 1, 50000));
+    const size_t rounds = static_cast<size_t>(argOr(argc, argv, 2, 200));
+
+    ResourceCollection collection;
+    for (size_t i = 0; i < count; ++i) {
+        std::shared_ptr<Resource> resource;
+        if (i % 2) {
+            resource = std::make_shared<CPUResource>("N" + std::to_string(i), "Xeon", 1.0 + i % 7, 16 + i % 48, 2.2);
+        } else {
+            resource = std::make_shared<GPUResource>("N" + std::to_string(i), "H100", 8.0 + i % 5, 16896,
+                                                     i % 3 ? 80 : 40);
+        }
+        if (i % 10 == 0) {
+            resource->setStatus(ResourceStatus::IN_USE);
+        }
+        collection.addResource(resource);
+    }
+
+    Stopwatch watch;
+    ResourceCatalog catalog = ResourceCatalog::fromCollection(collection);
+    double buildMs = watch.elapsedMs();
+
+    // 对照：遍历集合中的资源对象，按类型读取属性
+    long long scanVram = 0, scanCores = 0;
+    double scanRate = 0;
+    watch.restart();
+    for (size_t r = 0; r < rounds; ++r) {
+        long long vram = 0, cores = 0;
+        double sum = 0;
+        size_t cpus = 0;
+        collection.forEachResource([&](const Resource& resource) {
+            double value = 0;
+            if (resource.getResourceType() == ResourceType::GPU) {
+                if (resource.isAvailable() && resource.getAttribute(ResourceAttribute::VRAM, value)) {
+                    vram += static_cast<long long>(value);
+                }
+            } else {
+                sum += resource.getHourlyRate();
+                ++cpus;
+                if (resource.isAvailable() && resource.getAttribute(ResourceAttribute::CORE_COUNT, value)) {
+                    cores += static_cast<long long>(value);
+                }
+            }
+        });
+        scanVram = vram;
+        scanCores = cores;
+        scanRate = cpus == 0 ? 0.0 : sum / cpus;
+    }
+    double scanUs = watch.elapsedUs() / static_cast<double>(rounds);
+
+    long long columnVram = 0, columnCores = 0;
+    double columnRate = 0;
+    watch.restart();
+    for (size_t r = 0; r < rounds; ++r) {
+        columnVram = catalog.totalIdleVRAM();
+        columnRate = catalog.averageHourlyRate(ResourceType::CPU);
+        columnCores = catalog.totalIdleCores();
+    }
+    double columnUs = watch.elapsedUs() / static_cast<double>(rounds);
+
+    bool same = scanVram == columnVram && scanCores == columnCores && scanRate == columnRate;
+    std::cout << count << " 个资源, " << rounds << " 轮 (每轮三项聚合)\n";
+    std::cout << "构建目录快照: " << buildMs << " ms\n";
+    std::cout << "遍历资源对象: " << scanUs << " us/轮, 列式目录 " << columnUs << " us/轮"
+              << (same ? "" : " (结果不一致!)") << "\n";
+    return same ? 0 : 1;
+}
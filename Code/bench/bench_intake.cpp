@@ -0,0 +1,83 @@
+// bench_intake.cpp
+// 提交租赁请求的延迟 p50/p99：RentalIntake 异步受理队列，
+// 与调用方在互斥量下直接校验（模拟 RentalManager 加锁后同步校验）的对比
+// 用法: bench_intake [总提交数=200000] [每条校验的循环次数=200]
+#include <iostream>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../include/RentalIntake.hpp"
+#include "BenchCommon.hpp"
+
+int main(int argc, char** argv) {
+    const size_t total = static_cast<size_t>(argOr(argc, argv, 1, 200000));
+    const long validationLoops = argOr(argc, argv, 2, 200);
+    const auto t0 = std::chrono::system_clock::now();
+
+    // 模拟校验的耗时
+    auto validate = [validationLoops](IntakeItem& item) {
+        volatile double sink = 0;
+        for (long k = 0; k < validationLoops; ++k) {
+            sink = sink + static_cast<double>(k) * 1.0001;
+        }
+        if (item.request.userId.empty()) {
+            item.reject("用户ID为空");
+        }
+    };
+
+    for (size_t producers : {size_t(1), size_t(8), size_t(64)}) {
+        const size_t perProducer = total / producers;
+        for (bool useIntake : {true, false}) {
+            std::mutex managerMutex;
+            std::vector<std::vector<double>> latency(producers);
+            std::vector<std::vector<std::future<IntakeResult>>> futures(producers);
+            {
+                RentalIntake intake([&](IntakeBatch batch) {
+                    std::lock_guard<std::mutex> lock(managerMutex);
+                    for (IntakeItem& item : batch) {
+                        validate(item);
+                    }
+                });
+                std::vector<std::thread> threads;
+                for (size_t t = 0; t < producers; ++t) {
+                    threads.emplace_back([&, t] {
+                        latency[t].reserve(perProducer);
+                        futures[t].reserve(perProducer);
+                        for (size_t i = 0; i < perProducer; ++i) {
+                            RentalRequest request("q" + std::to_string(i), "user", "res", t0, std::chrono::hours(1));
+                            Stopwatch watch;
+                            if (useIntake) {
+                                futures[t].push_back(intake.submit(std::move(request)));
+                            } else {
+                                std::lock_guard<std::mutex> lock(managerMutex);
+                                IntakeItem item(std::move(request));
+                                validate(item);
+                            }
+                            latency[t].push_back(watch.elapsedUs());
+                        }
+                    });
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+                for (auto& list : futures) {
+                    for (auto& future : list) {
+                        future.get();
+                    }
+                }
+            }
+            std::vector<double> all;
+            for (auto& list : latency) {
+                all.insert(all.end(), list.begin(), list.end());
+            }
+            double p50 = percentile(all, 50);
+            double p99 = percentile(all, 99);
+            std::printf("%2zu 个生产者  %-16s p50 %7.2f us  p99 %7.2f us\n", producers,
+                        useIntake ? "异步受理" : "加锁同步校验", p50, p99);
+        }
+    }
+    return 0;
+}
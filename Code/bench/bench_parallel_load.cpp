@@ -0,0 +1,61 @@
+// bench_parallel_load.cpp
+// users.dat 分块格式的并行加载：不同线程数下 UserCollection::loadFromFile 的耗时（三次取最好），以及加载后的用户名查找
+// 用法: bench_parallel_load [用户数=1000000]
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+
+#include "../include/User.hpp"
+#include "BenchCommon.hpp"
+
+int main(int argc, char** argv) {
+    const size_t count = static_cast<size_t>(argOr(argc, argv, 1, 1000000));
+    const std::string filename = "bench_users.dat";
+
+    {
+        UserCollection users;
+        for (size_t i = 0; i < count; ++i) {
+            std::string n = std::to_string(i);
+            if (i % 3 == 0) {
+                users.addUser(std::make_shared<Teacher>("t" + n, "tn" + n, "pw" + n, static_cast<double>(i % 1000)));
+            } else {
+                users.addUser(std::make_shared<Student>("s" + n, "sn" + n, "pw" + n));
+            }
+        }
+        users.saveToFile(filename);
+    }
+
+    bool ok = true;
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        double best = 1e300;
+        for (int round = 0; round < 3; ++round) {
+            UserCollection loaded;
+            Stopwatch watch;
+            loaded.loadFromFile(filename, threads);
+            best = std::min(best, watch.elapsedMs());
+            ok = ok && loaded.size() == count;
+        }
+        std::cout << count << " 个用户, " << threads << " 线程加载: " << best << " ms\n";
+    }
+
+    UserCollection loaded;
+    loaded.loadFromFile(filename);
+    const size_t lookups = 100000;
+    std::vector<std::string> names;
+    names.reserve(lookups);
+    for (size_t i = 0; i < lookups; ++i) {
+        size_t index = (i * 7919) % count;
+        names.push_back((index % 3 == 0 ? "tn" : "sn") + std::to_string(index));
+    }
+    size_t hits = 0;
+    Stopwatch watch;
+    for (const std::string& name : names) {
+        hits += loaded.findUserByUsername(name) != nullptr;
+    }
+    std::cout << "按用户名查找: " << watch.elapsedUs() / static_cast<double>(lookups) << " us/次\n";
+    std::remove(filename.c_str());
+    return ok && hits == lookups ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+// bench_resource_index.cpp
+// ResourceCollection 的ID、类型、状态索引与逐个扫描的对比
+// 用法: bench_resource_index [资源数=50000] [查询次数=2000]
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../include/Resource.hpp"
+#include "BenchCommon.hpp"
+
+int main(int argc, char** argv) {
+    const size_t count = static_cast<size_t>(argOr(argc, argv, 1, 50000));
+    const size_t lookups = static_cast<size_t>(argOr(argc, argv, 2, 2000));
+
+    ResourceCollection collection;
+    std::vector<std::shared_ptr<Resource>> plain; // 对照：只有一个 vector
+    for (size_t i = 0; i < count; ++i) {
+        std::shared_ptr<Resource> resource;
+        if (i % 2) {
+            resource = std::make_shared<CPUResource>("N" + std::to_string(i), "Xeon", 1.5, 16, 2.2);
+        } else {
+            resource = std::make_shared<GPUResource>("N" + std::to_string(i), "H100", 10.0, 16896, 80);
+        }
+        if (i % 10 == 0) {
+            resource->setStatus(ResourceStatus::IN_USE);
+        }
+        collection.addResource(resource);
+        plain.push_back(resource);
+    }
+
+    std::vector<std::string> ids;
+    ids.reserve(lookups);
+    for (size_t i = 0; i < lookups; ++i) {
+        ids.push_back("N" + std::to_string((i * 7919) % count));
+    }
+
+    size_t hits = 0;
+    Stopwatch watch;
+    for (const std::string& id : ids) {
+        for (const auto& resource : plain) {
+            if (resource->getResourceId() == id) {
+                ++hits;
+                break;
+            }
+        }
+    }
+    double scanUs = watch.elapsedUs() / static_cast<double>(lookups);
+
+    watch.restart();
+    for (const std::string& id : ids) {
+        hits += collection.findResourceById(id) != nullptr;
+    }
+    double hashUs = watch.elapsedUs() / static_cast<double>(lookups);
+
+    // 按类型、状态统计：扫描 vector 与索引桶
+    watch.restart();
+    size_t scanned = 0;
+    for (size_t i = 0; i < lookups; ++i) {
+        for (const auto& resource : plain) {
+            scanned += resource->getResourceType() == ResourceType::GPU && resource->isAvailable();
+        }
+    }
+    double scanCountUs = watch.elapsedUs() / static_cast<double>(lookups);
+
+    watch.restart();
+    size_t indexed = 0;
+    for (size_t i = 0; i < lookups; ++i) {
+        indexed += collection.countAvailableByType(ResourceType::GPU);
+    }
+    double indexCountUs = watch.elapsedUs() / static_cast<double>(lookups);
+
+    std::cout << count << " 个资源, " << lookups << " 次查询 (命中 " << hits << ")\n";
+    std::cout << "按ID查找:     逐个扫描 " << scanUs << " us/次, 哈希索引 " << hashUs << " us/次\n";
+    std::cout << "空闲GPU计数:  逐个扫描 " << scanCountUs << " us/次, 索引 " << indexCountUs << " us/次"
+              << (scanned == indexed ? "" : " (结果不一致!)") << "\n";
+    return scanned == indexed ? 0 : 1;
+}
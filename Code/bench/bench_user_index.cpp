@@ -0,0 +1,57 @@
+// bench_user_index.cpp
+// 按用户名登录：逐个扫描用户与 UserCollection 的用户名索引对比
+// 用法: bench_user_index [用户数=100000] [登录次数=2000]
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../include/User.hpp"
+#include "BenchCommon.hpp"
+
+int main(int argc, char** argv) {
+    const size_t count = static_cast<size_t>(argOr(argc, argv, 1, 100000));
+    const size_t logins = static_cast<size_t>(argOr(argc, argv, 2, 2000));
+    const size_t repeats = 100; // 索引查找太快，重复多轮取平均
+
+    UserCollection users;
+    std::vector<std::shared_ptr<User>> plain; // 对照：只有一个 vector
+    for (size_t i = 0; i < count; ++i) {
+        auto user = std::make_shared<Student>("s" + std::to_string(i), "user" + std::to_string(i), "pw");
+        users.addUser(user);
+        plain.push_back(user);
+    }
+
+    std::mt19937 rng(1);
+    std::vector<std::string> names;
+    names.reserve(logins);
+    for (size_t i = 0; i < logins; ++i) {
+        names.push_back("user" + std::to_string(rng() % count));
+    }
+
+    size_t scanHits = 0;
+    Stopwatch watch;
+    for (const std::string& name : names) {
+        for (const auto& user : plain) {
+            if (user->getUsername() == name) {
+                scanHits += user->verifyPassword("pw");
+                break;
+            }
+        }
+    }
+    double scanUs = watch.elapsedUs() / static_cast<double>(logins);
+
+    size_t indexHits = 0;
+    watch.restart();
+    for (size_t round = 0; round < repeats; ++round) {
+        for (const std::string& name : names) {
+            indexHits += users.login(name, "pw") != nullptr;
+        }
+    }
+    double indexUs = watch.elapsedUs() / static_cast<double>(logins * repeats);
+
+    std::cout << count << " 个学生, " << logins << " 次登录\n";
+    std::cout << "逐个扫描 " << scanUs << " us/次, 用户名索引 " << indexUs << " us/次\n";
+    return scanHits == logins && indexHits == logins * repeats ? 0 : 1;
+}
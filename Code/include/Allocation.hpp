@@ -0,0 +1,228 @@
+// Allocation.hpp
+#ifndef ALLOCATION_HPP
+#define ALLOCATION_HPP
+
+#include <string>
+#include <vector>
+#include <set>
+#include <array>
+#include <map>
+#include <optional>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include "ApprovalQueue.hpp"
+#include "Rental.hpp"
+#include "Resource.hpp"
+#include "User.hpp"
+
+// 请求对资源的最低要求
+struct ResourceDemand {
+    ResourceType type = ResourceType::CPU;
+    int minCapacity = 0;      // CPU 为核心数，GPU 为显存（G）
+    double maxHourlyRate = 0; // 每小时价格上限，0 表示不限
+};
+
+// 资源在 ResourceDemand::minCapacity 意义下的容量
+inline int resourceCapacity(const Resource& resource) {
+    double value = 0;
+    ResourceAttribute attribute = resource.getResourceType() == ResourceType::CPU ? ResourceAttribute::CORE_COUNT
+                                                                                  : ResourceAttribute::VRAM;
+    resource.getAttribute(attribute, value);
+    return static_cast<int>(value);
+}
+
+// 参与批量分配的一条待审批请求
+struct AllocationRequest {
+    RentalRequest* request; // 指向调用方持有的请求，提交时原地修改
+    UserRole role;
+    ResourceDemand demand;
+};
+
+// 一条分配结果
+struct Assignment {
+    RentalRequest* request;
+    std::shared_ptr<Resource> resource;
+};
+
+struct AllocationPlan {
+    std::vector<Assignment> assignments;  // 按审批优先级排列
+    std::vector<RentalRequest*> unmatched; // 通过策略检查但没有合适的空闲资源
+    std::vector<RentalRequest*> refused;   // 未通过策略检查
+};
+
+/**
+ * @class AllocationEngine
+ * @brief 批量审批：一次把所有待审批请求匹配到空闲资源。
+ *
+ * 分两步进行：
+ *  - plan：不修改任何状态。请求按 (用户优先级, 请求时间) 排序，
+ *    每种类型的空闲资源按容量分桶，桶内按价格排序，
+ *    依次为每个请求取容量满足要求的最小资源（同容量取最便宜），即最佳适配。
+ *    有价格上限时每个容量桶只需看最便宜的一个，代价与不同容量的个数有关，与空闲资源数无关。
+ *    请求已指定资源ID时只匹配该资源。
+ *    同一请求重复出现时只按第一次参与分配。
+ *  - apply：先校验计划中的请求和资源各不重复、请求仍待审批、资源仍空闲，全部通过后才
+ *    把请求置为 APPROVED 并占用资源；任何一项校验失败则抛出异常且不做修改。
+ * 非线程安全，调用方需在批量审批期间独占请求和资源集合。
+ */
+class AllocationEngine {
+private:
+    struct Slot {
+        int capacity;
+        double rate;
+        uint32_t order; // 同容量同价格时按集合中的顺序
+        std::shared_ptr<Resource> resource;
+
+        bool operator<(const Slot& other) const {
+            if (rate != other.rate) return rate < other.rate;
+            return order < other.order;
+        }
+    };
+
+    using SlotSet = std::set<Slot>;               // 同一容量的空闲资源，按 (价格, 顺序)
+    using CapacityIndex = std::map<int, SlotSet>; // 容量 -> 空闲资源
+
+    struct SlotRef {
+        CapacityIndex::iterator bucket;
+        SlotSet::iterator slot;
+    };
+
+    static bool fits(const Slot& slot, const ResourceDemand& demand) {
+        return slot.capacity >= demand.minCapacity && (demand.maxHourlyRate <= 0 || slot.rate <= demand.maxHourlyRate);
+    }
+
+    // 最佳适配：容量满足要求的最小桶中最便宜且不超价的资源；桶内最便宜的超价则整桶跳过
+    static std::optional<SlotRef> bestFit(CapacityIndex& index, const ResourceDemand& demand) {
+        for (auto bucket = index.lower_bound(demand.minCapacity); bucket != index.end(); ++bucket) {
+            auto cheapest = bucket->second.begin();
+            if (fits(*cheapest, demand)) {
+                return SlotRef{bucket, cheapest};
+            }
+        }
+        return std::nullopt;
+    }
+
+    static void take(CapacityIndex& index, const SlotRef& ref) {
+        ref.bucket->second.erase(ref.slot);
+        if (ref.bucket->second.empty()) {
+            index.erase(ref.bucket);
+        }
+    }
+
+public:
+    // 默认策略：全部放行
+    struct AcceptAll {
+        bool operator()(const RentalRequest&, UserRole) const { return true; }
+    };
+
+    // 计算分配方案。policy(const RentalRequest&, UserRole) 返回false的请求不参与分配，
+    // 可在此检查配额、余额或预约冲突
+    template <typename Policy = AcceptAll>
+    static AllocationPlan plan(const ResourceCollection& collection, const std::vector<AllocationRequest>& requests,
+                               Policy policy = Policy()) {
+        AllocationPlan result;
+
+        // 同一请求出现多次时只保留第一次，否则会被分配两份资源
+        std::vector<uint32_t> order;
+        order.reserve(requests.size());
+        std::unordered_set<const RentalRequest*> seen;
+        seen.reserve(requests.size());
+        for (uint32_t i = 0; i < requests.size(); ++i) {
+            const AllocationRequest& entry = requests[i];
+            if (entry.request->status != RentalStatus::PENDING_APPROVAL || !seen.insert(entry.request).second) {
+                continue;
+            }
+            if (policy(static_cast<const RentalRequest&>(*entry.request), entry.role)) {
+                order.push_back(i);
+            } else {
+                result.refused.push_back(entry.request);
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [&requests](uint32_t a, uint32_t b) {
+            uint8_t pa = kApprovalPriority[static_cast<size_t>(requests[a].role)];
+            uint8_t pb = kApprovalPriority[static_cast<size_t>(requests[b].role)];
+            if (pa != pb) return pa < pb;
+            return requests[a].request->requestTime < requests[b].request->requestTime;
+        });
+
+        // 空闲资源按类型、容量建立有序索引，另按ID索引以处理指定资源的请求
+        std::array<CapacityIndex, kResourceTypeCount> slots;
+        std::unordered_map<std::string, SlotRef> byId;
+        byId.reserve(collection.countAvailable());
+        uint32_t position = 0;
+        collection.forEachSharedAvailable([&](const std::shared_ptr<Resource>& resource) {
+            CapacityIndex& index = slots[static_cast<size_t>(resource->getResourceType())];
+            int capacity = resourceCapacity(*resource);
+            auto bucket = index.try_emplace(capacity).first;
+            auto inserted = bucket->second.insert(Slot{capacity, resource->getHourlyRate(), position++, resource});
+            byId.emplace(resource->getResourceId(), SlotRef{bucket, inserted.first});
+        });
+
+        result.assignments.reserve(order.size());
+        for (uint32_t index : order) {
+            const AllocationRequest& entry = requests[index];
+            CapacityIndex& typeSlots = slots[static_cast<size_t>(entry.demand.type)];
+            std::optional<SlotRef> chosen;
+            if (!entry.request->resourceId.empty()) {
+                auto pinned = byId.find(entry.request->resourceId);
+                if (pinned != byId.end() && pinned->second.slot->resource->getResourceType() == entry.demand.type &&
+                    fits(*pinned->second.slot, entry.demand)) {
+                    chosen = pinned->second;
+                }
+            } else {
+                chosen = bestFit(typeSlots, entry.demand);
+            }
+            if (!chosen) {
+                result.unmatched.push_back(entry.request);
+                continue;
+            }
+            std::shared_ptr<Resource> resource = chosen->slot->resource;
+            byId.erase(resource->getResourceId());
+            take(typeSlots, *chosen);
+            result.assignments.push_back(Assignment{entry.request, std::move(resource)});
+        }
+        return result;
+    }
+
+    // 提交分配方案：全部校验通过后统一置为 APPROVED 并占用资源
+    static void apply(const AllocationPlan& plan) {
+        std::unordered_set<const RentalRequest*> requests;
+        std::unordered_set<const Resource*> resources;
+        requests.reserve(plan.assignments.size());
+        resources.reserve(plan.assignments.size());
+        for (const Assignment& assignment : plan.assignments) {
+            if (!requests.insert(assignment.request).second) {
+                throw std::runtime_error("分配方案中租赁请求重复: " + assignment.request->requestId);
+            }
+            if (!resources.insert(assignment.resource.get()).second) {
+                throw std::runtime_error("分配方案中资源重复: " + assignment.resource->getResourceId());
+            }
+            if (assignment.request->status != RentalStatus::PENDING_APPROVAL) {
+                throw std::runtime_error("租赁请求已不在待审批状态: " + assignment.request->requestId);
+            }
+            if (!assignment.resource->isAvailable()) {
+                throw std::runtime_error("资源已被占用: " + assignment.resource->getResourceId());
+            }
+        }
+        for (const Assignment& assignment : plan.assignments) {
+            assignment.request->resourceId = assignment.resource->getResourceId();
+            assignment.request->status = RentalStatus::APPROVED;
+            assignment.resource->setStatus(ResourceStatus::IN_USE);
+        }
+    }
+
+    // 计算并提交，返回分配方案
+    template <typename Policy = AcceptAll>
+    static AllocationPlan approveAll(ResourceCollection& collection, const std::vector<AllocationRequest>& requests,
+                                     Policy policy = Policy()) {
+        AllocationPlan result = plan(collection, requests, policy);
+        apply(result);
+        return result;
+    }
+};
+
+#endif // ALLOCATION_HPP
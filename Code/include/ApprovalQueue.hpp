@@ -0,0 +1,164 @@
+// ApprovalQueue.hpp
+#ifndef APPROVAL_QUEUE_HPP
+#define APPROVAL_QUEUE_HPP
+
+#include <string>
+#include <vector>
+#include <set>
+#include <array>
+#include <cstdint>
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+#include "Rental.hpp"
+#include "Resource.hpp"
+#include "User.hpp"
+
+// 审批优先级，数值越小越优先，顺序与 UserRole 一致（STUDENT, TEACHER, ADMIN）。
+// 业务规则 七.1 只规定教师优先于学生；管理员自己提交的租赁请求与教师同级，
+// 二者之间按请求时间先到先得，不另设更高一级，以免管理员的请求挤占教师。
+// AllocationEngine 和 GangScheduler 也使用这张表。
+constexpr std::array<uint8_t, kUserRoleCount> kApprovalPriority = {1, 0, 0};
+
+/**
+ * @class ApprovalQueue
+ * @brief 待审批租赁请求队列。
+ *
+ * 按业务规则 七.1：资源充足时先到先得，资源紧张时按用户类型优先（教师优先）。
+ * 每种资源类型各有两个有序集合，分别按 (优先级, 请求时间) 和请求时间排序，
+ * 另有一个跨类型的按 (优先级, 请求时间) 排序的集合供管理员列表使用。
+ * 入队、取消、出队均为 O(log n)，取待审批列表时直接按序遍历，无需重新排序。
+ * 请求时间相同时按入队顺序。
+ */
+class ApprovalQueue {
+private:
+    struct Entry {
+        RentalRequest request;
+        UserRole role;
+        ResourceType type;
+        uint64_t seq;
+    };
+
+    // 集合中的键，指向 entries 中的节点（unordered_map 节点地址在重哈希时不变）
+    struct Key {
+        uint8_t priority;
+        std::chrono::system_clock::time_point time;
+        uint64_t seq;
+        Entry* entry;
+
+        bool operator<(const Key& other) const {
+            if (priority != other.priority) return priority < other.priority;
+            if (time != other.time) return time < other.time;
+            return seq < other.seq;
+        }
+    };
+
+    struct TypeQueues {
+        std::set<Key> byPriority; // (优先级, 请求时间)
+        std::set<Key> byArrival;  // 请求时间（优先级字段置0）
+    };
+
+    std::unordered_map<std::string, Entry> entries; // 请求ID -> 条目
+    std::array<TypeQueues, kResourceTypeCount> queues;
+    std::set<Key> allByPriority;
+    uint64_t nextSeq = 0;
+
+    static Key priorityKey(Entry& entry) {
+        return Key{kApprovalPriority[static_cast<size_t>(entry.role)], entry.request.requestTime, entry.seq, &entry};
+    }
+    static Key arrivalKey(Entry& entry) {
+        return Key{0, entry.request.requestTime, entry.seq, &entry};
+    }
+
+    TypeQueues& queueOf(ResourceType type) { return queues[static_cast<size_t>(type)]; }
+    const TypeQueues& queueOf(ResourceType type) const { return queues[static_cast<size_t>(type)]; }
+
+    RentalRequest take(Entry& entry) {
+        TypeQueues& queue = queueOf(entry.type);
+        queue.byPriority.erase(priorityKey(entry));
+        queue.byArrival.erase(arrivalKey(entry));
+        allByPriority.erase(priorityKey(entry));
+        RentalRequest request = std::move(entry.request);
+        entries.erase(request.requestId);
+        return request;
+    }
+
+public:
+    // 入队，请求ID已存在时返回false
+    bool push(const RentalRequest& request, UserRole role, ResourceType type) {
+        auto inserted = entries.emplace(request.requestId, Entry{request, role, type, nextSeq});
+        if (!inserted.second) {
+            return false;
+        }
+        ++nextSeq;
+        Entry& entry = inserted.first->second;
+        TypeQueues& queue = queueOf(type);
+        queue.byPriority.insert(priorityKey(entry));
+        queue.byArrival.insert(arrivalKey(entry));
+        allByPriority.insert(priorityKey(entry));
+        return true;
+    }
+
+    // 取消（用户撤回或管理员直接处理），不存在时返回false
+    bool cancel(const std::string& requestId) {
+        auto it = entries.find(requestId);
+        if (it == entries.end()) {
+            return false;
+        }
+        take(it->second);
+        return true;
+    }
+
+    // 取出下一个待审批请求：资源紧张时按优先级，否则先到先得
+    std::optional<RentalRequest> pop(ResourceType type, bool scarce) {
+        const TypeQueues& queue = queueOf(type);
+        const std::set<Key>& order = scarce ? queue.byPriority : queue.byArrival;
+        if (order.empty()) {
+            return std::nullopt;
+        }
+        return take(*order.begin()->entry);
+    }
+
+    // 根据空闲资源数判断是否紧张：待审批请求多于空闲资源时视为紧张
+    std::optional<RentalRequest> pop(ResourceType type, const ResourceCollection& collection) {
+        return pop(type, isScarce(type, collection));
+    }
+
+    bool isScarce(ResourceType type, const ResourceCollection& collection) const {
+        return size(type) > collection.countAvailableByType(type);
+    }
+
+    // 按审批顺序遍历某类型的待审批请求，回调参数为 const RentalRequest&
+    template <typename Visitor>
+    void forEachPending(ResourceType type, bool scarce, Visitor visit) const {
+        const TypeQueues& queue = queueOf(type);
+        for (const Key& key : scarce ? queue.byPriority : queue.byArrival) {
+            visit(static_cast<const RentalRequest&>(key.entry->request));
+        }
+    }
+
+    // 管理员待审批列表：所有类型按 (优先级, 请求时间)
+    std::vector<RentalRequest> getPendingRentalRequests() const {
+        std::vector<RentalRequest> result;
+        result.reserve(entries.size());
+        for (const Key& key : allByPriority) {
+            result.push_back(key.entry->request);
+        }
+        return result;
+    }
+
+    // 某类型的待审批列表
+    std::vector<RentalRequest> getPendingRentalRequests(ResourceType type, bool scarce = true) const {
+        std::vector<RentalRequest> result;
+        result.reserve(size(type));
+        forEachPending(type, scarce, [&result](const RentalRequest& request) { result.push_back(request); });
+        return result;
+    }
+
+    bool contains(const std::string& requestId) const { return entries.count(requestId) != 0; }
+    size_t size() const { return entries.size(); }
+    size_t size(ResourceType type) const { return queueOf(type).byArrival.size(); }
+    bool empty() const { return entries.empty(); }
+};
+
+#endif // APPROVAL_QUEUE_HPP
@@ -0,0 +1,109 @@
+// BalanceLedger.hpp
+#ifndef BALANCE_LEDGER_HPP
+#define BALANCE_LEDGER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cmath>
+
+// 金额以最小货币单位（分）的整数表示，避免浮点累计误差
+using Money = int64_t;
+
+inline Money toMinorUnits(double yuan) { return static_cast<Money>(std::llround(yuan * 100.0)); }
+inline double fromMinorUnits(Money cents) { return static_cast<double>(cents) / 100.0; }
+
+/**
+ * @class BalanceAccount
+ * @brief 无锁的账户余额。
+ *
+ * 余额分为可用和已预留两部分，均为原子整数。扣款、预留、确认和退还都用 CAS 循环完成，
+ * 先检查后修改在同一次原子操作中生效，任何并发交错下可用余额和预留余额都不会为负。
+ * 典型计费流程：租用前 reserve 预估费用，结束后 commit 实际费用并 refund 剩余部分。
+ * 每个账户独占一条缓存行，不同账户的并发更新互不干扰。
+ * 各计数器之间没有需要同步的其他数据，因此使用 relaxed 内存序。
+ */
+class alignas(64) BalanceAccount {
+private:
+    std::atomic<Money> available;
+    std::atomic<Money> reserved{0};
+
+    // 在 amount 不超过当前值时原子地减去，成功返回true
+    static bool takeFrom(std::atomic<Money>& counter, Money amount) {
+        Money current = counter.load(std::memory_order_relaxed);
+        do {
+            if (current < amount) {
+                return false;
+            }
+        } while (!counter.compare_exchange_weak(current, current - amount, std::memory_order_relaxed));
+        return true;
+    }
+
+public:
+    explicit BalanceAccount(Money initial = 0) : available(initial) {}
+
+    BalanceAccount(const BalanceAccount&) = delete;
+    BalanceAccount& operator=(const BalanceAccount&) = delete;
+
+    Money getAvailable() const { return available.load(std::memory_order_relaxed); }
+    Money getReserved() const { return reserved.load(std::memory_order_relaxed); }
+
+    // 覆盖可用余额（用于反序列化），调用时不得有并发操作
+    void reset(Money amount) {
+        available.store(amount, std::memory_order_relaxed);
+        reserved.store(0, std::memory_order_relaxed);
+    }
+
+    bool deposit(Money amount) {
+        if (amount < 0) {
+            return false;
+        }
+        available.fetch_add(amount, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 直接扣款，可用余额不足时失败
+    bool withdraw(Money amount) {
+        return amount >= 0 && takeFrom(available, amount);
+    }
+
+    // 按当前可用余额决定扣款额并原子扣除：pick(可用余额) 返回不超过该余额的非负金额。
+    // 只有余额被并发修改导致 CAS 失败时才以新余额重新调用 pick；返回实际扣除的金额
+    template <typename Pick>
+    Money withdrawPicked(Pick pick) {
+        Money current = available.load(std::memory_order_relaxed);
+        while (true) {
+            Money amount = pick(current);
+            if (amount <= 0 || amount > current) {
+                return 0;
+            }
+            if (available.compare_exchange_weak(current, current - amount, std::memory_order_relaxed)) {
+                return amount;
+            }
+        }
+    }
+
+    // 从可用余额中预留，余额不足时失败
+    bool reserve(Money amount) {
+        if (amount < 0 || !takeFrom(available, amount)) {
+            return false;
+        }
+        reserved.fetch_add(amount, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 确认扣除已预留的金额
+    bool commit(Money amount) {
+        return amount >= 0 && takeFrom(reserved, amount);
+    }
+
+    // 将已预留的金额退回可用余额
+    bool refund(Money amount) {
+        if (amount < 0 || !takeFrom(reserved, amount)) {
+            return false;
+        }
+        available.fetch_add(amount, std::memory_order_relaxed);
+        return true;
+    }
+};
+
+#endif // BALANCE_LEDGER_HPP
@@ -0,0 +1,327 @@
+// BinaryFormat.hpp
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define BINARY_FORMAT_USE_FSYNC 1
+#endif
+
+// v2 数据文件格式
+//   文件头（32字节）：魔数[4] 版本u16 标志u16 记录数u64 负载长度u64 校验和u64
+//   负载：连续记录，每条记录先写定长字段，再写长度前缀(u32)字符串
+// 数值按本机字节序写入（与旧格式一致），校验和为负载按8字节分组的 FNV-1a 64 位哈希
+//
+// 标志含 kBinaryFlagBlockIndex 时，记录之后附有块索引，可按块并行解码：
+//   每块一项：块偏移u64（相对负载开头） 块长度u64 记录数u64 块校验和u64，
+//   之后是全部块项的校验和u64，最后是块数u64。各块须首尾相接、恰好覆盖块索引之前的全部记录
+// 顺序读取的程序只读前“记录数”条记录，不受块索引影响
+constexpr uint16_t kBinaryFormatVersion = 2;
+constexpr size_t kBinaryHeaderSize = 32;
+constexpr uint16_t kBinaryFlagBlockIndex = 1;
+constexpr size_t kBinaryBlockEntrySize = 32;
+
+inline uint64_t payloadChecksum(const char* data, size_t size) {
+    const uint64_t prime = 1099511628211ULL;
+    uint64_t hash = 1469598103934665603ULL;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+    }
+    return hash;
+}
+
+// 块索引中的一项
+struct BinaryBlock {
+    uint64_t offset = 0;      // 相对负载开头
+    uint64_t size = 0;
+    uint64_t recordCount = 0;
+    uint64_t checksum = 0;
+};
+
+/**
+ * @class BinaryWriter
+ * @brief 将记录追加到一块连续缓冲区，最后一次性写入文件。
+ *
+ * 缓冲区开头预留文件头位置，finish() 时回填记录数、长度和校验和。
+ * 写入过程中调用 closeBlock() 划分记录块时，finish() 会在记录之后追加块索引。
+ */
+class BinaryWriter {
+private:
+    std::string buffer;
+    std::vector<BinaryBlock> blocks;
+    uint64_t blockStart = 0; // 当前块的起始偏移（相对负载开头）
+
+    void appendBlockIndex() {
+        size_t indexStart = buffer.size();
+        for (const auto& block : blocks) {
+            put(block.offset);
+            put(block.size);
+            put(block.recordCount);
+            put(block.checksum);
+        }
+        put(payloadChecksum(buffer.data() + indexStart, buffer.size() - indexStart));
+        put(static_cast<uint64_t>(blocks.size()));
+        blocks.clear();
+    }
+
+public:
+    explicit BinaryWriter(size_t reserveBytes = 1 << 16) {
+        buffer.reserve(reserveBytes);
+        buffer.resize(kBinaryHeaderSize);
+    }
+
+    template <typename T>
+    void put(const T& value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void putString(const std::string& value) {
+        put(static_cast<uint32_t>(value.size()));
+        buffer.append(value);
+    }
+
+    void putBytes(const char* data, size_t size) {
+        buffer.append(data, size);
+    }
+
+    size_t size() const { return buffer.size(); }
+
+    // 把上次划分之后写入的内容作为一个记录块
+    void closeBlock(uint64_t recordCount) {
+        uint64_t end = buffer.size() - kBinaryHeaderSize;
+        if (end == blockStart && recordCount == 0) {
+            return;
+        }
+        blocks.push_back(BinaryBlock{blockStart, end - blockStart, recordCount,
+                                     payloadChecksum(buffer.data() + kBinaryHeaderSize + blockStart, end - blockStart)});
+        blockStart = end;
+    }
+
+    // 不含文件头的正文部分
+    std::string payload() const { return buffer.substr(kBinaryHeaderSize); }
+
+    // 回填文件头并返回完整文件内容
+    const std::string& finish(const char magic[4], uint64_t recordCount) {
+        uint16_t flags = 0;
+        if (!blocks.empty()) {
+            appendBlockIndex();
+            flags |= kBinaryFlagBlockIndex;
+        }
+        uint64_t payloadSize = buffer.size() - kBinaryHeaderSize;
+        uint64_t checksum = payloadChecksum(buffer.data() + kBinaryHeaderSize, payloadSize);
+        uint16_t version = kBinaryFormatVersion;
+        char* header = &buffer[0];
+        std::memcpy(header, magic, 4);
+        std::memcpy(header + 4, &version, sizeof(version));
+        std::memcpy(header + 6, &flags, sizeof(flags));
+        std::memcpy(header + 8, &recordCount, sizeof(recordCount));
+        std::memcpy(header + 16, &payloadSize, sizeof(payloadSize));
+        std::memcpy(header + 24, &checksum, sizeof(checksum));
+        return buffer;
+    }
+
+    // 回填文件头并整体写入文件
+    void writeToFile(const std::string& filename, const char magic[4], uint64_t recordCount) {
+        const std::string& data = finish(magic, recordCount);
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("无法打开文件进行写入: " + filename);
+        }
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            throw std::runtime_error("写入文件失败: " + filename);
+        }
+    }
+};
+
+/**
+ * @class BinaryReader
+ * @brief 在内存缓冲区上按顺序读取字段，越界时抛出异常。
+ */
+class BinaryReader {
+private:
+    const char* cursor;
+    const char* end;
+
+    void require(size_t n) const {
+        if (static_cast<size_t>(end - cursor) < n) {
+            throw std::runtime_error("数据文件已损坏：记录越界");
+        }
+    }
+
+public:
+    BinaryReader(const char* data, size_t size) : cursor(data), end(data + size) {}
+
+    template <typename T>
+    T get() {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+
+    std::string getString() {
+        uint32_t length = get<uint32_t>();
+        require(length);
+        std::string value(cursor, length);
+        cursor += length;
+        return value;
+    }
+
+    void skip(size_t n) {
+        require(n);
+        cursor += n;
+    }
+
+    const char* position() const { return cursor; }
+    size_t remaining() const { return static_cast<size_t>(end - cursor); }
+};
+
+/**
+ * @struct BinaryFileHeader
+ * @brief v2 文件头的解析结果。
+ */
+struct BinaryFileHeader {
+    uint16_t version = 0;
+    uint16_t flags = 0;
+    uint64_t recordCount = 0;
+    uint64_t payloadSize = 0;
+    uint64_t checksum = 0;
+};
+
+// 解析并校验内存中的文件头，魔数不符时返回false（可能是旧格式文件）
+inline bool parseBinaryHeader(const char* data, size_t size, const char magic[4], BinaryFileHeader& header) {
+    if (size < kBinaryHeaderSize || std::memcmp(data, magic, 4) != 0) {
+        return false;
+    }
+    std::memcpy(&header.version, data + 4, sizeof(header.version));
+    std::memcpy(&header.flags, data + 6, sizeof(header.flags));
+    std::memcpy(&header.recordCount, data + 8, sizeof(header.recordCount));
+    std::memcpy(&header.payloadSize, data + 16, sizeof(header.payloadSize));
+    std::memcpy(&header.checksum, data + 24, sizeof(header.checksum));
+    if (header.version != kBinaryFormatVersion) {
+        throw std::runtime_error("不支持的数据文件版本: " + std::to_string(header.version));
+    }
+    if (header.payloadSize != size - kBinaryHeaderSize) {
+        throw std::runtime_error("数据文件已损坏：长度不符");
+    }
+    return true;
+}
+
+// 读取块索引，文件没有块索引时返回false
+inline bool readBlockIndex(const char* data, const BinaryFileHeader& header, std::vector<BinaryBlock>& blocks) {
+    blocks.clear();
+    if (!(header.flags & kBinaryFlagBlockIndex)) {
+        return false;
+    }
+    const char* payload = data + kBinaryHeaderSize;
+    uint64_t count;
+    uint64_t indexChecksum;
+    const size_t trailerSize = sizeof(indexChecksum) + sizeof(count);
+    if (header.payloadSize < trailerSize) {
+        throw std::runtime_error("数据文件已损坏：块索引缺失");
+    }
+    std::memcpy(&count, payload + header.payloadSize - sizeof(count), sizeof(count));
+    std::memcpy(&indexChecksum, payload + header.payloadSize - trailerSize, sizeof(indexChecksum));
+    if (count > (header.payloadSize - trailerSize) / kBinaryBlockEntrySize) {
+        throw std::runtime_error("数据文件已损坏：块索引越界");
+    }
+    uint64_t indexStart = header.payloadSize - trailerSize - count * kBinaryBlockEntrySize;
+    if (payloadChecksum(payload + indexStart, count * kBinaryBlockEntrySize) != indexChecksum) {
+        throw std::runtime_error("数据文件已损坏：块索引校验失败");
+    }
+    // 校验和之外再检查各块首尾相接，保证工作线程只会读取块索引之前的记录区
+    BinaryReader reader(payload + indexStart, count * kBinaryBlockEntrySize);
+    blocks.resize(count);
+    uint64_t records = 0;
+    uint64_t expectedOffset = 0;
+    for (auto& block : blocks) {
+        block.offset = reader.get<uint64_t>();
+        block.size = reader.get<uint64_t>();
+        block.recordCount = reader.get<uint64_t>();
+        block.checksum = reader.get<uint64_t>();
+        if (block.offset != expectedOffset || block.size > indexStart - block.offset ||
+            block.recordCount > block.size) {
+            throw std::runtime_error("数据文件已损坏：记录块越界");
+        }
+        expectedOffset = block.offset + block.size;
+        records += block.recordCount;
+    }
+    if (expectedOffset != indexStart) {
+        throw std::runtime_error("数据文件已损坏：记录块未覆盖全部记录");
+    }
+    if (records != header.recordCount) {
+        throw std::runtime_error("数据文件已损坏：块索引记录数不符");
+    }
+    return true;
+}
+
+// 整体读入文件；是v2格式时校验文件头和校验和并返回true，否则返回false
+// verifyChecksum 为false时跳过整体校验（由调用方按块校验）
+inline bool readBinaryFile(const std::string& filename, const char magic[4],
+                           std::vector<char>& data, BinaryFileHeader& header, bool verifyChecksum = true) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("无法打开文件进行读取: " + filename);
+    }
+    std::streamsize size = file.tellg();
+    file.seekg(0);
+    data.resize(static_cast<size_t>(size));
+    if (size > 0 && !file.read(data.data(), size)) {
+        throw std::runtime_error("读取文件失败: " + filename);
+    }
+    if (!parseBinaryHeader(data.data(), data.size(), magic, header)) {
+        return false;
+    }
+    if (verifyChecksum && payloadChecksum(data.data() + kBinaryHeaderSize, header.payloadSize) != header.checksum) {
+        throw std::runtime_error("数据文件校验失败: " + filename);
+    }
+    return true;
+}
+
+// 把文件（或目录）已写入的内容刷到磁盘；不支持 fsync 的平台为空操作
+inline void syncToDisk(const std::string& path) {
+#ifdef BINARY_FORMAT_USE_FSYNC
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("无法打开文件进行同步: " + path);
+    }
+    int result = ::fsync(fd);
+    ::close(fd);
+    if (result != 0) {
+        throw std::runtime_error("同步文件到磁盘失败: " + path);
+    }
+#else
+    (void)path;
+#endif
+}
+
+// 用已写完的临时文件替换目标文件：先刷盘临时文件，再改名，最后刷盘所在目录，
+// 保证崩溃后目标文件要么是旧内容，要么是完整的新内容
+inline void replaceFileDurably(const std::string& tmp, const std::string& target) {
+    syncToDisk(tmp);
+    if (std::rename(tmp.c_str(), target.c_str()) != 0) {
+        throw std::runtime_error("无法替换文件: " + target);
+    }
+    std::filesystem::path dir = std::filesystem::path(target).parent_path();
+    syncToDisk(dir.empty() ? "." : dir.string());
+}
+
+#endif // BINARY_FORMAT_HPP
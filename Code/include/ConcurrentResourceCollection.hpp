@@ -0,0 +1,372 @@
+// ConcurrentResourceCollection.hpp
+#ifndef CONCURRENT_RESOURCE_COLLECTION_HPP
+#define CONCURRENT_RESOURCE_COLLECTION_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <cstdint>
+#include <unordered_map>
+#include "Resource.hpp"
+
+class ConcurrentResourceCollection;
+
+/**
+ * @class ResourceSnapshot
+ * @brief 资源集合的一个不可变版本。
+ *
+ * 发布后其中的资源对象和索引都不再改变，读者可以在任意线程无锁地遍历和查找，
+ * 持有期间不受管理员写入影响。修改只能通过 ConcurrentResourceCollection 产生新版本。
+ * 返回的资源指针在持有该版本期间有效，不增减任何引用计数。
+ */
+class ResourceSnapshot {
+private:
+    friend class ConcurrentResourceCollection;
+
+    std::vector<std::shared_ptr<const Resource>> resources;
+    std::unordered_map<std::string, size_t> idIndex; // 资源ID -> resources 中的位置
+    std::map<ResourceType, size_t> freeCounts;
+    uint64_t version = 0;
+
+    void reindexFrom(size_t first) {
+        for (size_t i = first; i < resources.size(); ++i) {
+            idIndex[resources[i]->getResourceId()] = i;
+        }
+    }
+
+    void countIn(const Resource& resource, bool add) {
+        if (resource.isAvailable()) {
+            size_t& count = freeCounts[resource.getResourceType()];
+            add ? ++count : --count;
+        }
+    }
+
+public:
+    uint64_t getVersion() const { return version; }
+    size_t size() const { return resources.size(); }
+
+    const std::vector<std::shared_ptr<const Resource>>& getAllResources() const { return resources; }
+
+    const Resource* findResourceById(const std::string& id) const {
+        auto it = idIndex.find(id);
+        return it == idIndex.end() ? nullptr : resources[it->second].get();
+    }
+
+    size_t countAvailableByType(ResourceType type) const {
+        auto it = freeCounts.find(type);
+        return it == freeCounts.end() ? 0 : it->second;
+    }
+
+    template <typename Visitor>
+    void forEachResource(Visitor visit) const {
+        for (const auto& resource : resources) {
+            visit(*resource);
+        }
+    }
+
+    template <typename Visitor>
+    void forEachAvailableByType(ResourceType type, Visitor visit) const {
+        for (const auto& resource : resources) {
+            if (resource->getResourceType() == type && resource->isAvailable()) {
+                visit(*resource);
+            }
+        }
+    }
+};
+
+/**
+ * @class ConcurrentResourceCollection
+ * @brief 支持多读者并发浏览的资源集合（写时复制 + 原子发布 + 纪元回收）。
+ *
+ * 当前版本由 std::atomic<const ResourceSnapshot*> 发布。读者通过 snapshot() 取得 SnapshotGuard：
+ * 在读者槽位表中占用一个槽位并写入当前纪元，再读取版本指针，之后的读取都在该不可变版本上进行。
+ * 整个过程只有一次 CAS 和几次原子读，不加锁、不等待写者；每个线程优先使用自己的槽位（独占缓存行），
+ * 读者之间也不争用同一个引用计数。
+ * 写者之间用互斥量串行：复制当前版本（只复制指针），对被修改的资源先 clone 再修改，
+ * 然后原子地替换版本指针，把旧版本连同当时的纪元放入待回收列表并推进纪元。
+ * 旧版本在所有仍持有它的读者（槽位中的纪元不大于它的退休纪元）释放后，由下一次写入回收。
+ * 同时持有版本的读者超过 kReaderSlots 个时，新读者自旋等待空闲槽位，因此读者应尽快释放 guard。
+ * 单次写入代价为 O(n) 的指针复制，批量修改应使用 update() 合并为一次发布。
+ * followStatusOf() 把它注册为源集合的状态观察者，审批分配、整组调度等对资源状态的修改
+ * 会各自发布为新版本，浏览者看到的空闲数量随之更新。
+ */
+class ConcurrentResourceCollection : public ResourceStatusObserver {
+public:
+    /**
+     * @class Editor
+     * @brief update() 中对新版本的修改接口。
+     */
+    class Editor {
+    private:
+        friend class ConcurrentResourceCollection;
+        ResourceSnapshot& next;
+
+        explicit Editor(ResourceSnapshot& s) : next(s) {}
+
+        // 取得可修改的副本并替换到新版本中
+        std::shared_ptr<Resource> mutableCopy(size_t pos) {
+            auto copy = next.resources[pos]->clone();
+            next.resources[pos] = copy;
+            return copy;
+        }
+
+    public:
+        // 加入资源的副本，调用方之后对原对象的修改不影响已发布版本
+        bool addResource(const Resource& resource) {
+            if (next.idIndex.count(resource.getResourceId())) {
+                return false;
+            }
+            auto copy = resource.clone();
+            next.idIndex.emplace(copy->getResourceId(), next.resources.size());
+            next.countIn(*copy, true);
+            next.resources.push_back(std::move(copy));
+            return true;
+        }
+
+        bool removeResource(const std::string& id) {
+            auto it = next.idIndex.find(id);
+            if (it == next.idIndex.end()) {
+                return false;
+            }
+            size_t pos = it->second;
+            next.countIn(*next.resources[pos], false);
+            next.idIndex.erase(it);
+            next.resources.erase(next.resources.begin() + pos);
+            next.reindexFrom(pos);
+            return true;
+        }
+
+        bool setStatus(const std::string& id, ResourceStatus status) {
+            auto it = next.idIndex.find(id);
+            if (it == next.idIndex.end()) {
+                return false;
+            }
+            next.countIn(*next.resources[it->second], false);
+            auto copy = mutableCopy(it->second);
+            copy->setStatus(status);
+            next.countIn(*copy, true);
+            return true;
+        }
+
+        bool modifyResource(const std::string& id, const std::string& newName, double newRate) {
+            auto it = next.idIndex.find(id);
+            if (it == next.idIndex.end()) {
+                return false;
+            }
+            auto copy = mutableCopy(it->second);
+            copy->setResourceName(newName);
+            copy->setHourlyRate(newRate);
+            return true;
+        }
+
+        void setHourlyRateByType(ResourceType type, double newRate) {
+            for (size_t pos = 0; pos < next.resources.size(); ++pos) {
+                if (next.resources[pos]->getResourceType() == type) {
+                    mutableCopy(pos)->setHourlyRate(newRate);
+                }
+            }
+        }
+    };
+
+    static constexpr size_t kReaderSlots = 128;
+
+    /**
+     * @class SnapshotGuard
+     * @brief 读者持有的一个版本；存续期间该版本不会被回收，不可复制。
+     */
+    class SnapshotGuard {
+    private:
+        friend class ConcurrentResourceCollection;
+        std::atomic<uint64_t>* slot = nullptr;
+        const ResourceSnapshot* snapshot = nullptr;
+
+        SnapshotGuard(std::atomic<uint64_t>* s, const ResourceSnapshot* snap) : slot(s), snapshot(snap) {}
+
+    public:
+        SnapshotGuard(const SnapshotGuard&) = delete;
+        SnapshotGuard& operator=(const SnapshotGuard&) = delete;
+
+        SnapshotGuard(SnapshotGuard&& other) noexcept
+            : slot(std::exchange(other.slot, nullptr)), snapshot(std::exchange(other.snapshot, nullptr)) {}
+
+        SnapshotGuard& operator=(SnapshotGuard&& other) noexcept {
+            if (this != &other) {
+                release();
+                slot = std::exchange(other.slot, nullptr);
+                snapshot = std::exchange(other.snapshot, nullptr);
+            }
+            return *this;
+        }
+
+        ~SnapshotGuard() { release(); }
+
+        // 提前释放；之后不得再访问该版本
+        void release() {
+            if (slot) {
+                slot->store(0, std::memory_order_release);
+                slot = nullptr;
+                snapshot = nullptr;
+            }
+        }
+
+        const ResourceSnapshot& operator*() const { return *snapshot; }
+        const ResourceSnapshot* operator->() const { return snapshot; }
+        const ResourceSnapshot* get() const { return snapshot; }
+    };
+
+private:
+    // 每个槽位独占一条缓存行，0 表示空闲，否则为占用者进入时的纪元
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};
+    };
+
+    std::atomic<const ResourceSnapshot*> current;
+    std::atomic<uint64_t> epoch{1};
+    mutable std::array<ReaderSlot, kReaderSlots> readers;
+    std::vector<std::pair<uint64_t, const ResourceSnapshot*>> retired; // 退休纪元、旧版本，由写锁保护
+    std::mutex writeMutex;
+    ResourceCollection* followed = nullptr; // 跟随其状态变更的源集合
+
+    // 线程首选的槽位，不同线程依次错开
+    static size_t preferredSlot() {
+        static std::atomic<size_t> nextThread{0};
+        thread_local size_t slot = nextThread.fetch_add(1, std::memory_order_relaxed) % kReaderSlots;
+        return slot;
+    }
+
+    // 回收没有读者再持有的旧版本（持有写锁时调用）
+    void reclaim() {
+        uint64_t oldest = UINT64_MAX;
+        for (const ReaderSlot& reader : readers) {
+            uint64_t e = reader.epoch.load();
+            if (e != 0 && e < oldest) {
+                oldest = e;
+            }
+        }
+        auto keep = retired.begin();
+        for (auto& entry : retired) {
+            if (entry.first < oldest) {
+                delete entry.second;
+            } else {
+                *keep++ = entry;
+            }
+        }
+        retired.erase(keep, retired.end());
+    }
+
+public:
+    ConcurrentResourceCollection() : current(new ResourceSnapshot()) {}
+
+    // 由普通资源集合构建（复制全部资源）
+    explicit ConcurrentResourceCollection(const ResourceCollection& source) : ConcurrentResourceCollection() {
+        update([&source](Editor& editor) {
+            source.forEachResource([&editor](const Resource& resource) {
+                editor.addResource(resource);
+            });
+        });
+    }
+
+    ConcurrentResourceCollection(const ConcurrentResourceCollection&) = delete;
+    ConcurrentResourceCollection& operator=(const ConcurrentResourceCollection&) = delete;
+
+    // 析构时不得再有读者持有版本
+    ~ConcurrentResourceCollection() override {
+        stopFollowing();
+        delete current.load();
+        for (auto& entry : retired) {
+            delete entry.second;
+        }
+    }
+
+    // 读者入口：取得当前不可变版本
+    SnapshotGuard snapshot() const {
+        size_t i = preferredSlot();
+        for (size_t attempts = 1;; ++attempts) {
+            uint64_t e = epoch.load();
+            uint64_t idle = 0;
+            if (readers[i].epoch.compare_exchange_strong(idle, e)) {
+                // 槽位先于版本指针可见，写者据此判断旧版本是否仍被持有
+                return SnapshotGuard(&readers[i].epoch, current.load());
+            }
+            i = (i + 1) % kReaderSlots;
+            if (attempts % kReaderSlots == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // 写者入口：在当前版本的副本上批量修改后一次发布
+    template <typename Mutator>
+    void update(Mutator mutate) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        const ResourceSnapshot* old = current.load();
+        auto next = std::make_unique<ResourceSnapshot>(*old);
+        Editor editor(*next);
+        mutate(editor);
+        ++next->version;
+        current.store(next.release());
+        retired.emplace_back(epoch.fetch_add(1), old);
+        reclaim();
+    }
+
+    // 等待回收的旧版本数
+    size_t retiredCount() {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        reclaim();
+        return retired.size();
+    }
+
+    bool addResource(const Resource& resource) {
+        bool added = false;
+        update([&](Editor& editor) { added = editor.addResource(resource); });
+        return added;
+    }
+
+    bool removeResource(const std::string& id) {
+        bool removed = false;
+        update([&](Editor& editor) { removed = editor.removeResource(id); });
+        return removed;
+    }
+
+    bool setStatus(const std::string& id, ResourceStatus status) {
+        bool changed = false;
+        update([&](Editor& editor) { changed = editor.setStatus(id, status); });
+        return changed;
+    }
+
+    bool modifyResource(const std::string& id, const std::string& newName, double newRate) {
+        bool changed = false;
+        update([&](Editor& editor) { changed = editor.modifyResource(id, newName, newRate); });
+        return changed;
+    }
+
+    void setHourlyRateByType(ResourceType type, double newRate) {
+        update([&](Editor& editor) { editor.setHourlyRateByType(type, newRate); });
+    }
+
+    // 跟随源集合中的资源状态变更；源集合须在 stopFollowing() 或析构之前保持有效
+    void followStatusOf(ResourceCollection& source) {
+        stopFollowing();
+        followed = &source;
+        source.addStatusObserver(this);
+    }
+
+    void stopFollowing() {
+        if (followed) {
+            followed->removeStatusObserver(this);
+            followed = nullptr;
+        }
+    }
+
+    void onResourceStatusChanged(const Resource& resource, ResourceStatus) override {
+        setStatus(resource.getResourceId(), resource.getStatus());
+    }
+};
+
+#endif // CONCURRENT_RESOURCE_COLLECTION_HPP
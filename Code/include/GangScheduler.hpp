@@ -0,0 +1,258 @@
+// GangScheduler.hpp
+#ifndef GANG_SCHEDULER_HPP
+#define GANG_SCHEDULER_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include "Allocation.hpp"
+#include "ApprovalQueue.hpp"
+#include "Resource.hpp"
+#include "User.hpp"
+
+// 多节点租赁请求：nodeCount 个满足 demand 的同类资源，同时开始、同时结束
+struct GangRequest {
+    std::string gangId;
+    std::string userId;
+    UserRole role = UserRole::STUDENT;
+    ResourceDemand demand;
+    size_t nodeCount = 1;
+    std::chrono::hours duration{1}; // 申请时长，也是调度器估计的结束时间
+    std::chrono::system_clock::time_point submitTime;
+};
+
+// 一次整组分配
+struct GangAllocation {
+    std::string gangId;
+    std::vector<std::string> resourceIds;
+    std::chrono::system_clock::time_point start;
+    std::chrono::system_clock::time_point end;
+    bool backfilled = false; // 是否为回填（越过了排在前面的等待请求）
+};
+
+/**
+ * @class GangScheduler
+ * @brief 多节点请求的整组调度，带 EASY 回填。
+ *
+ * 一个请求要么同时拿到全部 nodeCount 个节点，要么一个也不拿，不会出现部分批准后节点闲置。
+ * 等待队列按 (用户优先级, 提交时间) 排序。队首请求的节点不够时，
+ * 按各节点的预计释放时间为它预留最早凑齐的 nodeCount 个节点，得到预留开始时间；
+ * 之后的请求只要不推迟这一预留就可以先行开始（回填）：
+ * 在预留开始前结束，或只使用不在预留集合中的空闲节点。
+ * 被外部占用的节点释放时间未知，不参与预留；其余节点凑不齐 nodeCount 个时，
+ * 预留其中能用的节点且不设开始时间，回填请求一律不得使用这些节点，队首不会因此饿死。
+ * 节点按 (是否预留, 容量, 价格) 最佳适配，尽量把大节点留给大请求。
+ * 分配和释放会同步修改资源状态。非线程安全。
+ */
+class GangScheduler {
+private:
+    using Clock = std::chrono::system_clock;
+
+    struct Node {
+        std::shared_ptr<Resource> resource;
+        int capacity;
+        Clock::time_point busyUntil; // 占用中节点的预计释放时间，外部占用为 max()
+        bool busy;
+    };
+
+    struct Pending {
+        GangRequest request;
+        uint64_t sequence;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Pending> queue; // 按调度顺序
+    std::unordered_map<std::string, std::vector<uint32_t>> running; // 组ID -> 节点下标
+    uint64_t nextSequence = 0;
+    bool backfill;
+
+    bool eligible(const Node& node, const ResourceDemand& demand) const {
+        return node.resource->getResourceType() == demand.type && node.capacity >= demand.minCapacity &&
+               (demand.maxHourlyRate <= 0 || node.resource->getHourlyRate() <= demand.maxHourlyRate);
+    }
+
+    static bool before(const Pending& a, const Pending& b) {
+        uint8_t pa = kApprovalPriority[static_cast<size_t>(a.request.role)];
+        uint8_t pb = kApprovalPriority[static_cast<size_t>(b.request.role)];
+        if (pa != pb) return pa < pb;
+        if (a.request.submitTime != b.request.submitTime) return a.request.submitTime < b.request.submitTime;
+        return a.sequence < b.sequence;
+    }
+
+    GangAllocation allocate(const GangRequest& request, std::vector<uint32_t>& picked, Clock::time_point now,
+                            bool backfilled) {
+        GangAllocation allocation{request.gangId, {}, now, now + request.duration, backfilled};
+        allocation.resourceIds.reserve(picked.size());
+        for (uint32_t index : picked) {
+            Node& node = nodes[index];
+            node.busy = true;
+            node.busyUntil = allocation.end;
+            node.resource->setStatus(ResourceStatus::IN_USE);
+            allocation.resourceIds.push_back(node.resource->getResourceId());
+        }
+        running.emplace(request.gangId, std::move(picked));
+        return allocation;
+    }
+
+    // 从候选空闲节点中按 (是否预留, 容量, 价格) 取前 count 个
+    void bestFit(std::vector<uint32_t>& candidates, size_t count, const std::vector<uint8_t>& reserved) const {
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                          [this, &reserved](uint32_t a, uint32_t b) {
+                              if (reserved[a] != reserved[b]) return reserved[a] < reserved[b];
+                              if (nodes[a].capacity != nodes[b].capacity) return nodes[a].capacity < nodes[b].capacity;
+                              double ra = nodes[a].resource->getHourlyRate();
+                              double rb = nodes[b].resource->getHourlyRate();
+                              if (ra != rb) return ra < rb;
+                              return a < b;
+                          });
+        candidates.resize(count);
+    }
+
+public:
+    // 以集合中的资源为节点；当前不空闲的资源视为被外部占用，直到调用 refresh
+    explicit GangScheduler(const ResourceCollection& collection, bool enableBackfill = true)
+        : backfill(enableBackfill) {
+        for (const auto& resource : collection.getAllResources()) {
+            nodes.push_back(Node{resource, resourceCapacity(*resource), Clock::time_point::max(),
+                                 !resource->isAvailable()});
+        }
+    }
+
+    void setBackfill(bool enabled) { backfill = enabled; }
+
+    // 同步外部占用的节点状态（不影响本调度器分配的节点）
+    void refresh() {
+        for (Node& node : nodes) {
+            if (node.busyUntil == Clock::time_point::max()) {
+                node.busy = !node.resource->isAvailable();
+            }
+        }
+    }
+
+    // 满足需求的节点总数
+    size_t eligibleCount(const ResourceDemand& demand) const {
+        size_t count = 0;
+        for (const Node& node : nodes) {
+            count += eligible(node, demand);
+        }
+        return count;
+    }
+
+    // 加入等待队列；满足需求的节点总数不足 nodeCount（永远无法满足）时返回false
+    bool submit(const GangRequest& request) {
+        if (request.nodeCount == 0) {
+            throw std::runtime_error("节点数必须大于0: " + request.gangId);
+        }
+        if (running.count(request.gangId) || std::any_of(queue.begin(), queue.end(), [&request](const Pending& p) {
+                return p.request.gangId == request.gangId;
+            })) {
+            throw std::runtime_error("多节点请求ID已存在: " + request.gangId);
+        }
+        if (eligibleCount(request.demand) < request.nodeCount) {
+            return false;
+        }
+        Pending pending{request, nextSequence++};
+        queue.insert(std::upper_bound(queue.begin(), queue.end(), pending, before), std::move(pending));
+        return true;
+    }
+
+    bool cancel(const std::string& gangId) {
+        auto it = std::find_if(queue.begin(), queue.end(),
+                               [&gangId](const Pending& p) { return p.request.gangId == gangId; });
+        if (it == queue.end()) {
+            return false;
+        }
+        queue.erase(it);
+        return true;
+    }
+
+    // 整组释放（正常结束或提前结束）
+    bool release(const std::string& gangId) {
+        auto it = running.find(gangId);
+        if (it == running.end()) {
+            return false;
+        }
+        for (uint32_t index : it->second) {
+            Node& node = nodes[index];
+            node.busy = false;
+            node.busyUntil = Clock::time_point::max();
+            node.resource->setStatus(ResourceStatus::IDLE);
+        }
+        running.erase(it);
+        return true;
+    }
+
+    // 在 now 时刻进行一轮调度，返回本轮开始的分配
+    std::vector<GangAllocation> schedule(Clock::time_point now) {
+        std::vector<GangAllocation> started;
+        std::vector<uint8_t> reserved(nodes.size(), 0);
+        bool haveReservation = false;
+        Clock::time_point shadow; // 预留开始时间，max() 表示开始时间未知，预留节点不得回填
+        std::vector<uint32_t> candidates;
+
+        for (auto it = queue.begin(); it != queue.end();) {
+            const GangRequest& request = it->request;
+            Clock::time_point end = now + request.duration;
+            bool mayUseReserved = !haveReservation || (shadow != Clock::time_point::max() && end <= shadow);
+            candidates.clear();
+            for (uint32_t i = 0; i < nodes.size(); ++i) {
+                const Node& node = nodes[i];
+                if (!node.busy && eligible(node, request.demand) && (!reserved[i] || mayUseReserved)) {
+                    candidates.push_back(i);
+                }
+            }
+
+            if (candidates.size() >= request.nodeCount) {
+                bestFit(candidates, request.nodeCount, reserved);
+                started.push_back(allocate(request, candidates, now, haveReservation));
+                it = queue.erase(it);
+                continue;
+            }
+
+            if (!haveReservation) {
+                // 为队首的等待请求预留最早能凑齐的节点，释放时间未知的外部占用节点不参与
+                candidates.clear();
+                for (uint32_t i = 0; i < nodes.size(); ++i) {
+                    if (eligible(nodes[i], request.demand) &&
+                        (!nodes[i].busy || nodes[i].busyUntil != Clock::time_point::max())) {
+                        candidates.push_back(i);
+                    }
+                }
+                auto freeAt = [this, now](uint32_t i) {
+                    return nodes[i].busy ? std::max(nodes[i].busyUntil, now) : now;
+                };
+                std::sort(candidates.begin(), candidates.end(), [&freeAt](uint32_t a, uint32_t b) {
+                    Clock::time_point fa = freeAt(a), fb = freeAt(b);
+                    return fa != fb ? fa < fb : a < b;
+                });
+                size_t count = std::min(candidates.size(), request.nodeCount);
+                for (size_t k = 0; k < count; ++k) {
+                    reserved[candidates[k]] = 1;
+                }
+                shadow = candidates.size() >= request.nodeCount ? freeAt(candidates[request.nodeCount - 1])
+                                                                : Clock::time_point::max();
+                haveReservation = true;
+                if (!backfill) {
+                    break;
+                }
+            }
+            ++it;
+        }
+        return started;
+    }
+
+    size_t pendingCount() const { return queue.size(); }
+    size_t runningCount() const { return running.size(); }
+    size_t nodeCount() const { return nodes.size(); }
+
+    size_t busyNodeCount() const {
+        return static_cast<size_t>(std::count_if(nodes.begin(), nodes.end(), [](const Node& n) { return n.busy; }));
+    }
+};
+
+#endif // GANG_SCHEDULER_HPP
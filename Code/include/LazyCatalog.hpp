@@ -0,0 +1,228 @@
+// LazyCatalog.hpp
+#ifndef LAZY_CATALOG_HPP
+#define LAZY_CATALOG_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+#include "BinaryFormat.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LAZY_CATALOG_USE_MMAP 1
+#endif
+
+/**
+ * @class MappedFile
+ * @brief 只读映射整个文件。
+ *
+ * POSIX 平台使用 mmap，其他平台退化为整体读入内存。
+ */
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t length = 0;
+#ifndef LAZY_CATALOG_USE_MMAP
+    std::vector<char> buffer;
+#endif
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // 移动后映射（或缓冲区）的地址不变，指向其中的指针和 string_view 仍然有效
+    MappedFile(MappedFile&& other) noexcept { swap(other); }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~MappedFile() { close(); }
+
+    void swap(MappedFile& other) noexcept {
+        std::swap(data, other.data);
+        std::swap(length, other.length);
+#ifndef LAZY_CATALOG_USE_MMAP
+        buffer.swap(other.buffer);
+#endif
+    }
+
+    void open(const std::string& filename) {
+        close();
+#ifdef LAZY_CATALOG_USE_MMAP
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("无法打开文件进行读取: " + filename);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("无法读取文件信息: " + filename);
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                length = 0;
+                throw std::runtime_error("无法映射文件: " + filename);
+            }
+            data = static_cast<const char*>(mapped);
+        }
+        ::close(fd);
+#else
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw std::runtime_error("无法打开文件进行读取: " + filename);
+        }
+        length = static_cast<size_t>(file.tellg());
+        file.seekg(0);
+        buffer.resize(length);
+        file.read(buffer.data(), static_cast<std::streamsize>(length));
+        data = buffer.data();
+#endif
+    }
+
+    void close() {
+#ifdef LAZY_CATALOG_USE_MMAP
+        if (data) {
+            ::munmap(const_cast<char*>(data), length);
+        }
+#else
+        buffer.clear();
+#endif
+        data = nullptr;
+        length = 0;
+    }
+
+    const char* begin() const { return data; }
+    size_t size() const { return length; }
+};
+
+/**
+ * @class LazyRecordFile
+ * @brief 延迟解码的 v2 数据文件。
+ *
+ * 打开时只映射文件并扫描一遍记录边界，建立偏移索引，不创建任何对象；
+ * 第一次访问某条记录时才解码为对象并缓存。按键查找的哈希索引在首次查找该键时建立，
+ * 键直接指向映射内存中的字节。
+ * 记录布局由 Traits 描述，须与对应类的 serialize(BinaryWriter&) 保持一致：
+ * Traits::kKeyCount 为可查找的键数（第0个为ID），Traits::key(reader, k) 返回记录中的第k个键，
+ * Traits::kMinRecordSize 为一条记录的最小字节数，用于在预留空间前约束文件头中的记录数。
+ * ResourceCollection::openLazily 与 UserCollection::openLazily 以此作为延迟加载模式的后备存储。
+ * 缓存的填充不是线程安全的。
+ */
+template <typename Traits>
+class LazyRecordFile {
+public:
+    using Record = typename Traits::Record;
+
+private:
+    using KeyIndex = std::unordered_map<std::string_view, size_t>;
+
+    MappedFile file;
+    BinaryFileHeader header;
+    std::vector<uint64_t> offsets; // 各记录相对文件开头的偏移，末尾多存一个结束偏移
+    mutable std::vector<std::shared_ptr<Record>> cache;
+    mutable std::array<KeyIndex, Traits::kKeyCount> keyIndex;
+    mutable std::array<bool, Traits::kKeyCount> keyIndexBuilt{};
+
+    BinaryReader readerAt(size_t index) const {
+        return BinaryReader(file.begin() + offsets[index], offsets[index + 1] - offsets[index]);
+    }
+
+    void buildKeyIndex(size_t k) const {
+        keyIndex[k].reserve(size());
+        for (size_t i = 0; i < size(); ++i) {
+            BinaryReader reader = readerAt(i);
+            keyIndex[k].emplace(Traits::key(reader, k), i);
+        }
+        keyIndexBuilt[k] = true;
+    }
+
+public:
+    // 映射文件并建立偏移索引；verifyChecksum 为true时会读遍整个文件
+    void open(const std::string& filename, bool verifyChecksum = false) {
+        file.open(filename);
+        offsets.clear();
+        cache.clear();
+        for (size_t k = 0; k < Traits::kKeyCount; ++k) {
+            keyIndex[k].clear();
+            keyIndexBuilt[k] = false;
+        }
+        if (!parseBinaryHeader(file.begin(), file.size(), Traits::magic(), header)) {
+            throw std::runtime_error("延迟加载仅支持 v2 格式文件: " + filename);
+        }
+        if (verifyChecksum &&
+            payloadChecksum(file.begin() + kBinaryHeaderSize, header.payloadSize) != header.checksum) {
+            throw std::runtime_error("数据文件校验失败: " + filename);
+        }
+
+        // 记录数不在校验和覆盖范围内（且可能跳过了整体校验），先用记录区长度约束它
+        uint64_t recordBytes = header.payloadSize;
+        std::vector<BinaryBlock> blocks;
+        if (readBlockIndex(file.begin(), header, blocks)) {
+            recordBytes = blocks.empty() ? 0 : blocks.back().offset + blocks.back().size;
+        }
+        if (header.recordCount > recordBytes / Traits::kMinRecordSize) {
+            throw std::runtime_error("数据文件已损坏：记录数不符");
+        }
+
+        offsets.reserve(header.recordCount + 1);
+        BinaryReader reader(file.begin() + kBinaryHeaderSize, recordBytes);
+        for (uint64_t i = 0; i < header.recordCount; ++i) {
+            offsets.push_back(static_cast<uint64_t>(reader.position() - file.begin()));
+            Traits::skip(reader);
+        }
+        // 记录数偏小时记录区会有剩余，不能静默隐藏后面的记录
+        if (reader.remaining() != 0) {
+            offsets.clear();
+            throw std::runtime_error("数据文件已损坏：记录数不符");
+        }
+        offsets.push_back(static_cast<uint64_t>(reader.position() - file.begin()));
+        cache.resize(header.recordCount);
+    }
+
+    size_t size() const { return cache.size(); }
+
+    bool isMaterialized(size_t index) const { return cache[index] != nullptr; }
+
+    // 按位置访问，首次访问时解码
+    std::shared_ptr<Record> at(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("记录下标越界");
+        }
+        if (!cache[index]) {
+            BinaryReader reader = readerAt(index);
+            cache[index] = Traits::decode(reader);
+        }
+        return cache[index];
+    }
+
+    // 按第k个键查找，未找到返回nullptr
+    std::shared_ptr<Record> findByKey(size_t k, const std::string& key) const {
+        if (!keyIndexBuilt[k]) {
+            buildKeyIndex(k);
+        }
+        auto it = keyIndex[k].find(std::string_view(key));
+        return it == keyIndex[k].end() ? nullptr : at(it->second);
+    }
+
+    // 按ID查找，未找到返回nullptr
+    std::shared_ptr<Record> findById(const std::string& id) const { return findByKey(0, id); }
+};
+
+#endif // LAZY_CATALOG_HPP
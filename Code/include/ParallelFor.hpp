@@ -0,0 +1,48 @@
+// ParallelFor.hpp
+#ifndef PARALLEL_FOR_HPP
+#define PARALLEL_FOR_HPP
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+// 在 threads 个线程上执行 task(0) … task(count-1)，任务按原子计数器动态领取
+// threads 为0时按CPU核数；调用线程也参与执行。
+// 所有任务结束后，若有任务抛出异常，重新抛出下标最小者的异常
+template <typename Task>
+void parallelFor(size_t count, unsigned threads, Task task) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, count)));
+
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            try {
+                task(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif // PARALLEL_FOR_HPP
@@ -0,0 +1,172 @@
+// Quota.hpp
+#ifndef QUOTA_HPP
+#define QUOTA_HPP
+
+#include <string>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <unordered_map>
+#include <stdexcept>
+#include "Resource.hpp"
+#include "User.hpp"
+
+// README 规定的配额：学生基础100点、研究生提升50%；教师基础300点、特定部门提升20%
+// 等级：学生 0 本科生、1 研究生；教师 0 普通部门、1 特定部门
+constexpr size_t kReadmeQuotaTierCount = 2;
+
+// 学生、教师的基础配额（点），顺序与 UserRole 一致
+constexpr std::array<int, 2> kBaseQuota = {100, 300};
+
+// 学生、教师各等级的配额倍率（百分比）
+constexpr std::array<std::array<int, kReadmeQuotaTierCount>, 2> kQuotaMultiplierPercent = {{
+    {100, 150}, // 学生：研究生提升50%
+    {100, 120}, // 教师：特定部门提升20%
+}};
+
+// 学生、教师的配额；超出的等级按最高等级计。管理员的配额不在 README 规定之内，由 QuotaPolicy 给出
+constexpr int readmeQuotaFor(UserRole role, size_t tier) {
+    return kBaseQuota[static_cast<size_t>(role)] *
+           kQuotaMultiplierPercent[static_cast<size_t>(role)]
+                                  [tier < kReadmeQuotaTierCount ? tier : kReadmeQuotaTierCount - 1] / 100;
+}
+
+static_assert(readmeQuotaFor(UserRole::STUDENT, 1) == 150, "研究生配额应为150点");
+static_assert(readmeQuotaFor(UserRole::TEACHER, 1) == 360, "特定部门教师配额应为360点");
+
+// README 未规定的部分，由部署方给出，没有缺省值
+struct QuotaPolicy {
+    std::vector<int> adminQuotaByTier;                    // 管理员各权限等级的配额（点），超出的等级按最高等级计
+    std::array<int, kResourceTypeCount> pointsPerHour{};  // 每小时消耗的配额点数，顺序与 ResourceType 一致
+};
+
+/**
+ * @class QuotaEngine
+ * @brief 缓存每个用户的配额与已用量。
+ *
+ * 学生、教师的配额由编译期常量表算出，管理员的配额和按资源类型的消耗取自构造时给出的 QuotaPolicy；
+ * 配额只在登记用户或调整等级时计算一次；
+ * 已用量在租赁开始/结束时增量更新，审批前的配额检查是一次哈希查找，
+ * 不需要重新汇总用户的活动租赁。
+ * 非线程安全。
+ */
+class QuotaEngine {
+public:
+    struct Entry {
+        UserRole role;
+        uint8_t tier;
+        int quota;
+        int used;
+
+        int remaining() const { return quota - used; }
+    };
+
+private:
+    QuotaPolicy policy;
+    std::unordered_map<std::string, Entry> entries;
+
+    int quotaFor(UserRole role, size_t tier) const {
+        if (role != UserRole::ADMIN) {
+            return readmeQuotaFor(role, tier);
+        }
+        const std::vector<int>& tiers = policy.adminQuotaByTier;
+        return tiers[tier < tiers.size() ? tier : tiers.size() - 1];
+    }
+
+    Entry& entryOf(const std::string& userId) {
+        auto it = entries.find(userId);
+        if (it == entries.end()) {
+            throw std::runtime_error("用户未登记配额: " + userId);
+        }
+        return it->second;
+    }
+
+    static void checkPoints(int points) {
+        if (points < 0) {
+            throw std::runtime_error("配额点数不能为负: " + std::to_string(points));
+        }
+    }
+
+public:
+    explicit QuotaEngine(QuotaPolicy quotaPolicy) : policy(std::move(quotaPolicy)) {
+        if (policy.adminQuotaByTier.empty()) {
+            throw std::runtime_error("未给出管理员配额");
+        }
+        for (int quota : policy.adminQuotaByTier) {
+            checkPoints(quota);
+        }
+        for (int points : policy.pointsPerHour) {
+            if (points <= 0) {
+                throw std::runtime_error("每小时配额消耗须为正: " + std::to_string(points));
+            }
+        }
+    }
+
+    // 为集合中的所有用户按默认等级登记
+    QuotaEngine(QuotaPolicy quotaPolicy, const UserCollection& users) : QuotaEngine(std::move(quotaPolicy)) {
+        entries.reserve(users.size());
+        users.forEachUser([this](const User& user) { registerUser(user); });
+    }
+
+    // 登记用户；已登记时只更新角色、等级和配额，保留已用量（活动租赁仍占用配额）
+    void registerUser(const User& user, uint8_t tier = 0) {
+        auto result = entries.try_emplace(user.getUserId(), Entry{user.getRole(), tier, 0, 0});
+        Entry& entry = result.first->second;
+        entry.role = user.getRole();
+        entry.tier = tier;
+        entry.quota = quotaFor(entry.role, tier);
+    }
+
+    void unregisterUser(const std::string& userId) { entries.erase(userId); }
+
+    // 调整等级（如升为研究生），已用量保留
+    void setTier(const std::string& userId, uint8_t tier) {
+        Entry& entry = entryOf(userId);
+        entry.tier = tier;
+        entry.quota = quotaFor(entry.role, tier);
+    }
+
+    // 查询缓存，未登记返回nullptr
+    const Entry* find(const std::string& userId) const {
+        auto it = entries.find(userId);
+        return it == entries.end() ? nullptr : &it->second;
+    }
+
+    // 审批前检查：剩余配额是否足够
+    bool canAfford(const std::string& userId, int points) const {
+        const Entry* entry = find(userId);
+        return entry && entry->remaining() >= points;
+    }
+
+    // 租用某类资源 duration 小时所需的配额点数
+    int pointsFor(ResourceType type, std::chrono::hours duration) const {
+        return policy.pointsPerHour[static_cast<size_t>(type)] * static_cast<int>(duration.count());
+    }
+
+    bool canAfford(const std::string& userId, ResourceType type, std::chrono::hours duration) const {
+        return canAfford(userId, pointsFor(type, duration));
+    }
+
+    // 租赁开始：配额足够时计入已用量并返回true
+    bool onRentalStarted(const std::string& userId, int points) {
+        checkPoints(points);
+        auto it = entries.find(userId);
+        if (it == entries.end() || it->second.remaining() < points) {
+            return false;
+        }
+        it->second.used += points;
+        return true;
+    }
+
+    // 租赁结束或取消：归还配额
+    void onRentalEnded(const std::string& userId, int points) {
+        checkPoints(points);
+        Entry& entry = entryOf(userId);
+        entry.used = entry.used > points ? entry.used - points : 0;
+    }
+
+    size_t size() const { return entries.size(); }
+};
+
+#endif // QUOTA_HPP
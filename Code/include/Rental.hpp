@@ -76,6 +76,17 @@ struct RentalRecord {
     // void completeRental(std::chrono::system_clock::time_point endTime, double cost);
 };
 
+inline RentalRequest::RentalRequest(std::string reqId, std::string uId, std::string resId,
+                                    std::chrono::system_clock::time_point startTime, std::chrono::hours duration)
+    : requestId(std::move(reqId)), userId(std::move(uId)), resourceId(std::move(resId)),
+      requestTime(std::chrono::system_clock::now()), desiredStartTime(startTime), durationHours(duration),
+      status(RentalStatus::PENDING_APPROVAL) {}
+
+inline RentalRecord::RentalRecord(std::string rentId, std::string reqId, std::string uId, std::string resId,
+                                  std::chrono::system_clock::time_point startTime)
+    : rentalId(std::move(rentId)), requestId(std::move(reqId)), userId(std::move(uId)), resourceId(std::move(resId)),
+      actualStartTime(startTime), actualEndTime(startTime), totalCost(0.0), status(RentalStatus::ACTIVE) {}
+
 /**
  * @class RentalManager
  * @brief 管理所有租赁请求和活动租赁。
@@ -114,6 +125,7 @@ public:
 
     // 系统操作
     // void updateRentalStatuses(); // 例如：根据时间将状态从APPROVED改为ACTIVE，从ACTIVE改为COMPLETED
+    //                               // 由 RentalTimers（TimerWheel.hpp）驱动，只处理到期的请求和租赁
     // void processCompletedRental(const RentalRecord& record); // 通知账单系统，更新资源状态
 
     // 持久化
@@ -0,0 +1,320 @@
+// RentalArchive.hpp
+#ifndef RENTAL_ARCHIVE_HPP
+#define RENTAL_ARCHIVE_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include "BalanceLedger.hpp"
+#include "Rental.hpp"
+
+/**
+ * @class RentalArchive
+ * @brief 已结束租赁的只追加归档。
+ *
+ * 记录按归档顺序（即结束时间的先后）写入固定大小的列式块：
+ * 开始时间（相对块基准的秒数）、时长、费用、状态各占一列，用户ID和资源ID驻留为 32 位编号，
+ * 租赁ID和请求ID以前缀压缩存放在块内的字符区（与上一条共享前缀，每 16 条重新开始），
+ * 每条记录不再持有独立的堆字符串。
+ * 每个用户、每个资源各有一条倒排表（归档序号的升序数组），
+ * 分页查询直接在倒排表上取片，代价只与结果条数有关。
+ * 时间精度为秒，费用精度为分。非线程安全。
+ */
+class RentalArchive {
+public:
+    static constexpr size_t kRecordsPerBlock = 4096;
+    static constexpr size_t kRestartInterval = 16;
+
+private:
+    using Clock = std::chrono::system_clock;
+
+    struct Block {
+        int64_t base = 0;                // 块内第一条记录的开始时间，纪元秒
+        std::vector<int32_t> start;      // 开始时间相对 base 的秒数
+        std::vector<uint32_t> duration;  // 时长，秒
+        std::vector<Money> cost;         // 费用，分
+        std::vector<uint8_t> status;
+        std::vector<uint32_t> user;      // 用户编号
+        std::vector<uint32_t> resource;  // 资源编号
+        std::vector<uint32_t> restart;   // 每 kRestartInterval 条在 ids 中的起点
+        std::string ids;                 // 依次为每条的租赁ID、请求ID，格式见 appendId
+        std::string lastRentalId;        // 前缀压缩的参照，只在写入时使用
+        std::string lastRequestId;
+        int64_t minEnd = INT64_MAX;
+        int64_t maxEnd = INT64_MIN;
+
+        Block() {
+            start.reserve(kRecordsPerBlock);
+            duration.reserve(kRecordsPerBlock);
+            cost.reserve(kRecordsPerBlock);
+            status.reserve(kRecordsPerBlock);
+            user.reserve(kRecordsPerBlock);
+            resource.reserve(kRecordsPerBlock);
+            restart.reserve(kRecordsPerBlock / kRestartInterval);
+        }
+
+        size_t size() const { return start.size(); }
+    };
+
+    // 字符串驻留：ID -> 编号，编号 -> 倒排表
+    struct Dictionary {
+        std::unordered_map<std::string, uint32_t> codes;
+        std::vector<std::string> names;
+        std::vector<std::vector<uint32_t>> postings;
+
+        uint32_t intern(const std::string& name) {
+            auto inserted = codes.try_emplace(name, static_cast<uint32_t>(names.size()));
+            if (inserted.second) {
+                names.push_back(name);
+                postings.emplace_back();
+            }
+            return inserted.first->second;
+        }
+
+        const std::vector<uint32_t>* find(const std::string& name) const {
+            auto it = codes.find(name);
+            return it == codes.end() ? nullptr : &postings[it->second];
+        }
+    };
+
+    std::vector<Block> blocks;
+    Dictionary users;
+    Dictionary resources;
+    size_t count = 0;
+
+    static int64_t toSeconds(Clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+    }
+
+    static Clock::time_point fromSeconds(int64_t seconds) {
+        return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(seconds)));
+    }
+
+    // 写入一个ID：共享前缀长度(1字节) + 后缀长度(1字节，255 表示其后另有4字节长度) + 后缀
+    static void appendId(std::string& out, std::string& last, const std::string& id, bool restartHere) {
+        size_t shared = 0;
+        if (!restartHere) {
+            size_t limit = std::min<size_t>({last.size(), id.size(), 255});
+            while (shared < limit && last[shared] == id[shared]) {
+                ++shared;
+            }
+        }
+        size_t suffix = id.size() - shared;
+        out.push_back(static_cast<char>(shared));
+        if (suffix < 255) {
+            out.push_back(static_cast<char>(suffix));
+        } else {
+            out.push_back(static_cast<char>(255));
+            uint32_t length = static_cast<uint32_t>(suffix);
+            out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        }
+        out.append(id, shared, suffix);
+        last = id;
+    }
+
+    static void readId(const std::string& in, size_t& pos, std::string& id) {
+        size_t shared = static_cast<uint8_t>(in[pos++]);
+        size_t suffix = static_cast<uint8_t>(in[pos++]);
+        if (suffix == 255) {
+            uint32_t length;
+            in.copy(reinterpret_cast<char*>(&length), sizeof(length), pos);
+            pos += sizeof(length);
+            suffix = length;
+        }
+        id.resize(shared);
+        id.append(in, pos, suffix);
+        pos += suffix;
+    }
+
+    // 字符串在对象之外占用的堆内存，短字符串（未超出内联容量）为0
+    static size_t heapBytes(const std::string& text) {
+        return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+    }
+
+    // 驻留字典占用的字节数：名称数组、倒排表数组，以及哈希表的桶和节点（节点按键值对加
+    // 后继指针和缓存的哈希值估算）
+    static size_t dictionaryUsage(const Dictionary& dictionary) {
+        size_t bytes = dictionary.names.capacity() * sizeof(std::string) +
+                       dictionary.postings.capacity() * sizeof(std::vector<uint32_t>) +
+                       dictionary.codes.bucket_count() * sizeof(void*) +
+                       dictionary.codes.size() *
+                           (sizeof(std::pair<const std::string, uint32_t>) + sizeof(void*) + sizeof(size_t));
+        for (const auto& name : dictionary.names) {
+            bytes += heapBytes(name);
+        }
+        for (const auto& entry : dictionary.codes) {
+            bytes += heapBytes(entry.first);
+        }
+        for (const auto& posting : dictionary.postings) {
+            bytes += posting.capacity() * sizeof(uint32_t);
+        }
+        return bytes;
+    }
+
+    // 从倒排表中按新到旧取一页
+    std::vector<RentalRecord> page(const std::vector<uint32_t>& posting, size_t offset, size_t limit) const {
+        std::vector<RentalRecord> result;
+        if (offset >= posting.size()) {
+            return result;
+        }
+        size_t end = posting.size() - offset;
+        size_t begin = end - std::min(limit, end);
+        result.reserve(end - begin);
+        for (size_t i = end; i > begin; --i) {
+            result.push_back(get(posting[i - 1]));
+        }
+        return result;
+    }
+
+public:
+    // 归档一条记录，返回归档序号
+    uint32_t append(const RentalRecord& record) {
+        if (blocks.empty() || blocks.back().size() == kRecordsPerBlock) {
+            blocks.emplace_back();
+        }
+        Block& block = blocks.back();
+        uint32_t index = static_cast<uint32_t>(count);
+        int64_t start = toSeconds(record.actualStartTime);
+        int64_t end = toSeconds(record.actualEndTime);
+        if (end < start || end - start > UINT32_MAX) {
+            throw std::runtime_error("租赁起止时间无效: " + record.rentalId);
+        }
+        if (block.size() == 0) {
+            block.base = start;
+        }
+        if (start - block.base < INT32_MIN || start - block.base > INT32_MAX) {
+            throw std::runtime_error("租赁开始时间超出归档块范围: " + record.rentalId);
+        }
+        uint32_t userCode = users.intern(record.userId);
+        uint32_t resourceCode = resources.intern(record.resourceId);
+
+        bool restartHere = block.size() % kRestartInterval == 0;
+        if (restartHere) {
+            block.restart.push_back(static_cast<uint32_t>(block.ids.size()));
+        }
+        appendId(block.ids, block.lastRentalId, record.rentalId, restartHere);
+        appendId(block.ids, block.lastRequestId, record.requestId, restartHere);
+        block.start.push_back(static_cast<int32_t>(start - block.base));
+        block.duration.push_back(static_cast<uint32_t>(end - start));
+        block.cost.push_back(toMinorUnits(record.totalCost));
+        block.status.push_back(static_cast<uint8_t>(record.status));
+        block.user.push_back(userCode);
+        block.resource.push_back(resourceCode);
+        if (block.size() == kRecordsPerBlock) {
+            // 块已写满，释放写入用的参照和字符区的多余容量
+            block.lastRentalId = std::string();
+            block.lastRequestId = std::string();
+            block.ids.shrink_to_fit();
+        }
+        block.minEnd = std::min(block.minEnd, end);
+        block.maxEnd = std::max(block.maxEnd, end);
+
+        users.postings[userCode].push_back(index);
+        resources.postings[resourceCode].push_back(index);
+        ++count;
+        return index;
+    }
+
+    // 按归档序号还原记录
+    RentalRecord get(uint32_t index) const {
+        if (index >= count) {
+            throw std::runtime_error("归档序号越界");
+        }
+        const Block& block = blocks[index / kRecordsPerBlock];
+        size_t i = index % kRecordsPerBlock;
+        // 从最近的重启点开始解码前缀压缩的ID
+        std::string rentalId;
+        std::string requestId;
+        size_t pos = block.restart[i / kRestartInterval];
+        for (size_t j = i - i % kRestartInterval; j <= i; ++j) {
+            readId(block.ids, pos, rentalId);
+            readId(block.ids, pos, requestId);
+        }
+        int64_t start = block.base + block.start[i];
+        RentalRecord record(std::move(rentalId), std::move(requestId), users.names[block.user[i]],
+                            resources.names[block.resource[i]], fromSeconds(start));
+        record.actualEndTime = fromSeconds(start + block.duration[i]);
+        record.totalCost = fromMinorUnits(block.cost[i]);
+        record.status = static_cast<RentalStatus>(block.status[i]);
+        return record;
+    }
+
+    // 用户的租赁历史，按新到旧分页
+    std::vector<RentalRecord> getUserRentalHistory(const std::string& userId, size_t offset = 0,
+                                                   size_t limit = SIZE_MAX) const {
+        const std::vector<uint32_t>* posting = users.find(userId);
+        return posting ? page(*posting, offset, limit) : std::vector<RentalRecord>{};
+    }
+
+    // 资源的租赁历史，按新到旧分页
+    std::vector<RentalRecord> getResourceRentalHistory(const std::string& resourceId, size_t offset = 0,
+                                                       size_t limit = SIZE_MAX) const {
+        const std::vector<uint32_t>* posting = resources.find(resourceId);
+        return posting ? page(*posting, offset, limit) : std::vector<RentalRecord>{};
+    }
+
+    // 全部历史，按新到旧分页
+    std::vector<RentalRecord> getAllRentalHistory(size_t offset = 0, size_t limit = SIZE_MAX) const {
+        std::vector<RentalRecord> result;
+        if (offset >= count) {
+            return result;
+        }
+        size_t end = count - offset;
+        size_t begin = end - std::min(limit, end);
+        result.reserve(end - begin);
+        for (size_t i = end; i > begin; --i) {
+            result.push_back(get(static_cast<uint32_t>(i - 1)));
+        }
+        return result;
+    }
+
+    // 遍历结束时间在 [from, to) 内的记录，跳过范围外的整块，回调参数为 const RentalRecord&
+    template <typename Visitor>
+    void forEachEndedBetween(Clock::time_point from, Clock::time_point to, Visitor visit) const {
+        int64_t lo = toSeconds(from);
+        int64_t hi = toSeconds(to);
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            const Block& block = blocks[b];
+            if (block.maxEnd < lo || block.minEnd >= hi) {
+                continue;
+            }
+            for (size_t i = 0; i < block.size(); ++i) {
+                int64_t end = block.base + block.start[i] + block.duration[i];
+                if (end >= lo && end < hi) {
+                    visit(static_cast<const RentalRecord&>(get(static_cast<uint32_t>(b * kRecordsPerBlock + i))));
+                }
+            }
+        }
+    }
+
+    size_t countForUser(const std::string& userId) const {
+        const std::vector<uint32_t>* posting = users.find(userId);
+        return posting ? posting->size() : 0;
+    }
+
+    size_t countForResource(const std::string& resourceId) const {
+        const std::vector<uint32_t>* posting = resources.find(resourceId);
+        return posting ? posting->size() : 0;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // 归档占用的总字节数：列数据、字符区，以及用户和资源两个驻留字典（含驻留字符串和哈希表）
+    size_t memoryUsage() const {
+        size_t bytes = blocks.capacity() * sizeof(Block);
+        for (const Block& block : blocks) {
+            bytes += block.start.capacity() * sizeof(int32_t) + block.duration.capacity() * sizeof(uint32_t) +
+                     block.cost.capacity() * sizeof(Money) + block.status.capacity() +
+                     (block.user.capacity() + block.resource.capacity() + block.restart.capacity()) * sizeof(uint32_t) +
+                     block.ids.capacity() + heapBytes(block.lastRentalId) + heapBytes(block.lastRequestId);
+        }
+        return bytes + dictionaryUsage(users) + dictionaryUsage(resources);
+    }
+};
+
+#endif // RENTAL_ARCHIVE_HPP
@@ -0,0 +1,252 @@
+// RentalIntake.hpp
+#ifndef RENTAL_INTAKE_HPP
+#define RENTAL_INTAKE_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <future>
+#include <functional>
+#include <condition_variable>
+#include <stdexcept>
+#include "Rental.hpp"
+
+// 异步受理的结果
+enum class IntakeStatus {
+    ACCEPTED, // 通过校验，已进入待审批
+    REJECTED  // 未通过校验（配额、余额、资源状态等）
+};
+
+struct IntakeResult {
+    std::string requestId;
+    IntakeStatus status = IntakeStatus::ACCEPTED;
+    std::string reason;
+};
+
+// 批处理中的一项，处理函数可修改请求并填写结果
+struct IntakeItem {
+    RentalRequest request;
+    IntakeStatus status = IntakeStatus::ACCEPTED;
+    std::string reason;
+
+    explicit IntakeItem(RentalRequest r) : request(std::move(r)) {}
+
+    void reject(std::string why) {
+        status = IntakeStatus::REJECTED;
+        reason = std::move(why);
+    }
+};
+
+// 交给批处理函数的一批请求：只能修改其中的条目，不能增删
+class IntakeBatch {
+private:
+    IntakeItem* items;
+    size_t count;
+
+public:
+    IntakeBatch(IntakeItem* first, size_t size) : items(first), count(size) {}
+
+    IntakeItem& operator[](size_t index) const { return items[index]; }
+    IntakeItem* begin() const { return items; }
+    IntakeItem* end() const { return items + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+/**
+ * @class RentalIntake
+ * @brief createRentalRequest 的异步受理队列。
+ *
+ * 提交方把请求压入无锁的多生产者单消费者队列（Vyukov 侵入式链表：
+ * 入队只有一次原子交换和一次写指针），立即得到 std::future。
+ * 唯一的消费线程每次取出一批请求，调用一次批处理函数完成校验和登记，
+ * 因此 RentalManager 的锁只由消费线程在每批中获取一次，不出现在用户的提交路径上。
+ * 消费线程空闲时休眠，生产者只在它休眠时才经过互斥量唤醒它。
+ * 析构时处理完已提交的请求再退出。
+ */
+class RentalIntake {
+public:
+    using BatchHandler = std::function<void(IntakeBatch)>;
+
+private:
+    struct NodeBase {
+        std::atomic<NodeBase*> next{nullptr};
+    };
+
+    struct Node : NodeBase {
+        RentalRequest request;
+        std::promise<IntakeResult> promise;
+
+        explicit Node(RentalRequest r) : request(std::move(r)) {}
+    };
+
+    BatchHandler handler;
+    size_t maxBatch;
+
+    // 生产者端指向最新节点，消费者端指向最旧节点；stub 保证队列永不为空链表
+    alignas(64) std::atomic<NodeBase*> head;
+    alignas(64) NodeBase* tail;
+    NodeBase stub;
+
+    alignas(64) std::atomic<bool> sleeping{false};
+    std::atomic<bool> stopping{false};
+    std::atomic<uint32_t> producers{0}; // 正在 submit 中的线程数，停止时等它们入队完毕
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<uint64_t> processedCount{0};
+    std::thread consumer;
+
+    // head 的交换与消费者休眠前对 head 的读取都是 seq_cst：生产者先换 head 再读 sleeping，
+    // 消费者先写 sleeping 再读 head，两边都是“先写后读”，只有全序才能保证至少一方看到另一方的写入
+    void push(NodeBase* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        NodeBase* prev = head.exchange(node, std::memory_order_seq_cst);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // 取出最旧的节点；队列为空或有生产者正在链接时返回nullptr
+    Node* pop() {
+        NodeBase* first = tail;
+        NodeBase* next = first->next.load(std::memory_order_acquire);
+        if (first == &stub) {
+            if (!next) {
+                return nullptr;
+            }
+            tail = next;
+            first = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail = next;
+            return static_cast<Node*>(first);
+        }
+        if (first != head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        push(&stub);
+        next = first->next.load(std::memory_order_acquire);
+        if (next) {
+            tail = next;
+            return static_cast<Node*>(first);
+        }
+        return nullptr;
+    }
+
+    bool empty() const { return head.load(std::memory_order_seq_cst) == tail; }
+
+    void run() {
+        std::vector<Node*> nodes;
+        std::vector<IntakeItem> items;
+        nodes.reserve(maxBatch);
+        items.reserve(maxBatch);
+        while (true) {
+            while (nodes.size() < maxBatch) {
+                Node* node = pop();
+                if (!node) {
+                    break;
+                }
+                nodes.push_back(node);
+            }
+            if (nodes.empty()) {
+                if (stopping.load() && producers.load() == 0 && empty()) {
+                    return;
+                }
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                sleeping.store(true, std::memory_order_seq_cst);
+                if (!empty() || stopping.load()) {
+                    // 休眠前再检查一次，避免错过刚入队的请求
+                    sleeping.store(false, std::memory_order_relaxed);
+                    lock.unlock();
+                    std::this_thread::yield();
+                    continue;
+                }
+                wake.wait(lock, [this] { return !sleeping.load(std::memory_order_acquire); });
+                continue;
+            }
+            process(nodes, items);
+        }
+    }
+
+    void process(std::vector<Node*>& nodes, std::vector<IntakeItem>& items) {
+        items.clear();
+        for (Node* node : nodes) {
+            items.emplace_back(std::move(node->request));
+        }
+        // 处理函数抛出任何异常都只拒绝本批，消费线程继续运行，每个 future 都会就绪
+        try {
+            handler(IntakeBatch(items.data(), items.size()));
+        } catch (const std::exception& e) {
+            for (auto& item : items) {
+                item.reject(std::string("受理失败: ") + e.what());
+            }
+        } catch (...) {
+            for (auto& item : items) {
+                item.reject("受理失败: 未知异常");
+            }
+        }
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            nodes[i]->promise.set_value(
+                IntakeResult{items[i].request.requestId, items[i].status, std::move(items[i].reason)});
+            delete nodes[i];
+        }
+        processedCount.fetch_add(nodes.size(), std::memory_order_relaxed);
+        nodes.clear();
+    }
+
+    void wakeConsumer() {
+        if (sleeping.exchange(false, std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wake.notify_one();
+        }
+    }
+
+public:
+    explicit RentalIntake(BatchHandler batchHandler, size_t batchSize = 256)
+        : handler(std::move(batchHandler)), maxBatch(batchSize == 0 ? 1 : batchSize), head(&stub), tail(&stub) {
+        consumer = std::thread([this] { run(); });
+    }
+
+    RentalIntake(const RentalIntake&) = delete;
+    RentalIntake& operator=(const RentalIntake&) = delete;
+
+    ~RentalIntake() { stop(); }
+
+    // 提交请求，可由任意线程并发调用；结果在消费线程处理完该批后就绪
+    std::future<IntakeResult> submit(RentalRequest request) {
+        // 先分配节点再登记为生产者，分配失败时不会留下未注销的计数让 stop 一直等待
+        auto node = std::make_unique<Node>(std::move(request));
+        std::future<IntakeResult> result = node->promise.get_future();
+        producers.fetch_add(1);
+        if (stopping.load()) {
+            producers.fetch_sub(1);
+            throw std::runtime_error("租赁受理队列已停止");
+        }
+        push(node.release());
+        producers.fetch_sub(1);
+        wakeConsumer();
+        return result;
+    }
+
+    // 停止受理，处理完已提交的请求后返回
+    void stop() {
+        if (stopping.exchange(true)) {
+            if (consumer.joinable()) {
+                consumer.join();
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            sleeping.store(false);
+            wake.notify_one();
+        }
+        consumer.join();
+    }
+
+    uint64_t processed() const { return processedCount.load(std::memory_order_relaxed); }
+};
+
+#endif // RENTAL_INTAKE_HPP
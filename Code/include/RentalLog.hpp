@@ -0,0 +1,568 @@
+// RentalLog.hpp
+#ifndef RENTAL_LOG_HPP
+#define RENTAL_LOG_HPP
+
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <stdexcept>
+#include <exception>
+#include <unordered_map>
+#include "BinaryFormat.hpp"
+#include "BalanceLedger.hpp"
+#include "Rental.hpp"
+
+// 允许的状态转换，行为原状态、列为新状态，顺序与 RentalStatus 一致
+constexpr size_t kRentalStatusCount = 7;
+constexpr std::array<std::array<bool, kRentalStatusCount>, kRentalStatusCount> kRentalTransitions = {{
+    //  PENDING APPROVED REJECTED ACTIVE COMPLETED CANCELLED EXPIRED
+    {false, true,  true,  false, false, true,  true },  // PENDING_APPROVAL
+    {false, false, false, true,  false, true,  false},  // APPROVED
+    {false, false, false, false, false, false, false},  // REJECTED
+    {false, false, false, false, true,  true,  false},  // ACTIVE
+    {false, false, false, false, false, false, false},  // COMPLETED
+    {false, false, false, false, false, false, false},  // CANCELLED
+    {false, false, false, false, false, false, false},  // EXPIRED
+}};
+
+constexpr bool canTransition(RentalStatus from, RentalStatus to) {
+    return kRentalTransitions[static_cast<size_t>(from)][static_cast<size_t>(to)];
+}
+
+// 租赁事件类型
+enum class RentalEventType : uint8_t {
+    REQUESTED = 1,  // 新请求：请求ID 用户ID 资源ID 请求时间 期望开始时间 时长(小时)
+    TRANSITION = 2, // 请求状态变更：请求ID 新状态 备注
+    STARTED = 3,    // 租赁开始（请求 APPROVED→ACTIVE）：请求ID 租赁ID 资源ID
+    FINISHED = 4,   // 租赁结束（ACTIVE→COMPLETED/CANCELLED）：租赁ID 新状态 费用(分)
+};
+
+// 解码后的事件，只有与类型相关的字段有效
+struct RentalEvent {
+    uint64_t sequence = 0;
+    RentalEventType type = RentalEventType::REQUESTED;
+    std::chrono::system_clock::time_point time; // 事件发生时间
+    std::string id;                             // 请求ID（FINISHED 为租赁ID）
+    std::string userId;
+    std::string resourceId;
+    std::string rentalId;                       // STARTED
+    std::chrono::system_clock::time_point desiredStartTime;
+    std::chrono::hours durationHours{0};
+    RentalStatus status = RentalStatus::PENDING_APPROVAL;
+    Money cost = 0;
+    std::string note;
+};
+
+/**
+ * @class RentalEventLog
+ * @brief 事件溯源的租赁状态机。
+ *
+ * 每次状态变化先校验转换表，再作为一条紧凑的二进制事件追加到日志文件，
+ * 最后应用到内存中的当前状态（请求表和租赁表）。日志只追加、不改写，即审计记录。
+ * 启动时读取最近的快照，再从快照记录的日志偏移处重放其后的事件，
+ * 每追加 kSnapshotInterval 条事件自动写一次快照，因此重启时重放的事件数有上限；
+ * 自动快照失败不影响已写入的事件，错误保存在 getSnapshotError()，下次提交时重试。
+ * 快照写成后当前日志改名为分段 <日志名>.<最后序号(20位)> 保留作审计，另起一个新日志，
+ * 启动时只读取当前日志中快照偏移之后的部分。
+ *
+ * 日志文件格式与 ResourceJournal 相同：魔数"RLOG" 版本u32，之后每条记录为 长度u32 校验u32 正文，
+ * 正文为 序号u64 类型u8 时间i64 及各类型字段，末尾不完整或校验失败的记录在加载时截断。
+ * 快照为 v2 数据文件，负载开头是 最后序号u64 日志偏移u64 请求数u64。
+ */
+class RentalEventLog {
+public:
+    static constexpr char kLogMagic[4] = {'R', 'L', 'O', 'G'};
+    static constexpr char kSnapshotMagic[4] = {'R', 'S', 'N', 'P'};
+    static constexpr uint64_t kSnapshotInterval = 100000;
+
+private:
+    using Clock = std::chrono::system_clock;
+    static constexpr size_t kFileHeaderSize = 8;
+    static constexpr size_t kEntryHeaderSize = 8;
+
+    std::string snapshotFile;
+    std::string logFile;
+    std::ofstream log;
+    uint64_t logBytes = 0;
+    uint64_t lastSequence = 0;
+    uint64_t eventsSinceSnapshot = 0;
+    std::exception_ptr snapshotError; // 最近一次自动快照的失败，成功后清除
+
+    std::unordered_map<std::string, RentalRequest> requests; // 请求ID -> 当前状态
+    std::unordered_map<std::string, RentalRecord> rentals;   // 租赁ID -> 当前状态
+
+    static int64_t ticks(Clock::time_point time) { return time.time_since_epoch().count(); }
+    static Clock::time_point fromTicks(int64_t value) { return Clock::time_point(Clock::duration(value)); }
+
+    void openLog() {
+        bool fresh = !std::filesystem::exists(logFile) || std::filesystem::file_size(logFile) == 0;
+        log.open(logFile, std::ios::binary | std::ios::app);
+        if (!log) {
+            throw std::runtime_error("无法打开租赁日志: " + logFile);
+        }
+        if (fresh) {
+            // 魔数和版本一次写出，崩溃时至多留下不足8字节的文件头，由 load() 截断
+            char header[kFileHeaderSize];
+            uint32_t version = kBinaryFormatVersion;
+            std::memcpy(header, kLogMagic, 4);
+            std::memcpy(header + 4, &version, sizeof(version));
+            log.write(header, kFileHeaderSize);
+            log.flush();
+        }
+        logBytes = std::filesystem::file_size(logFile);
+    }
+
+    // 事件正文的公共前缀
+    BinaryWriter beginEvent(RentalEventType type, Clock::time_point time) const {
+        BinaryWriter writer(128);
+        writer.put(lastSequence + 1);
+        writer.put(static_cast<uint8_t>(type));
+        writer.put(ticks(time));
+        return writer;
+    }
+
+    // 追加一条事件并应用到当前状态；写入失败时不修改状态并抛出异常
+    void commit(const BinaryWriter& writer) {
+        if (!log.is_open()) {
+            openLog();
+        }
+        std::string body = writer.payload();
+        std::string entry;
+        entry.reserve(kEntryHeaderSize + body.size());
+        uint32_t length = static_cast<uint32_t>(body.size());
+        uint32_t checksum = static_cast<uint32_t>(payloadChecksum(body.data(), body.size()));
+        entry.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        entry.append(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        entry.append(body);
+        log.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+        log.flush();
+        if (!log) {
+            throw std::runtime_error("写入租赁日志失败: " + logFile);
+        }
+        logBytes += entry.size();
+        BinaryReader reader(body.data(), body.size());
+        apply(decode(reader));
+        // 事件已写入并生效，快照失败不能再报告为本次操作失败：记下错误，计数不清零，下次提交时重试
+        if (++eventsSinceSnapshot >= kSnapshotInterval) {
+            try {
+                snapshot();
+                snapshotError = nullptr;
+            } catch (...) {
+                snapshotError = std::current_exception();
+            }
+        }
+    }
+
+    static RentalEvent decode(BinaryReader& reader) {
+        RentalEvent event;
+        event.sequence = reader.get<uint64_t>();
+        event.type = static_cast<RentalEventType>(reader.get<uint8_t>());
+        event.time = fromTicks(reader.get<int64_t>());
+        switch (event.type) {
+            case RentalEventType::REQUESTED:
+                event.id = reader.getString();
+                event.userId = reader.getString();
+                event.resourceId = reader.getString();
+                event.desiredStartTime = fromTicks(reader.get<int64_t>());
+                event.durationHours = std::chrono::hours(reader.get<int64_t>());
+                break;
+            case RentalEventType::TRANSITION:
+                event.id = reader.getString();
+                event.status = static_cast<RentalStatus>(reader.get<uint8_t>());
+                event.note = reader.getString();
+                break;
+            case RentalEventType::STARTED:
+                event.id = reader.getString();
+                event.rentalId = reader.getString();
+                event.resourceId = reader.getString();
+                event.status = RentalStatus::ACTIVE;
+                break;
+            case RentalEventType::FINISHED:
+                event.id = reader.getString();
+                event.status = static_cast<RentalStatus>(reader.get<uint8_t>());
+                event.cost = reader.get<Money>();
+                break;
+            default:
+                throw std::runtime_error("未知的租赁事件类型");
+        }
+        return event;
+    }
+
+    // 把事件应用到当前状态（事件在写入前已校验，重放时不再校验）
+    void apply(const RentalEvent& event) {
+        lastSequence = event.sequence;
+        switch (event.type) {
+            case RentalEventType::REQUESTED: {
+                RentalRequest request(event.id, event.userId, event.resourceId, event.desiredStartTime,
+                                      event.durationHours);
+                request.requestTime = event.time;
+                requests.insert_or_assign(event.id, std::move(request));
+                break;
+            }
+            case RentalEventType::TRANSITION: {
+                RentalRequest& request = requests.at(event.id);
+                request.status = event.status;
+                if (!event.note.empty()) {
+                    request.adminNotes = event.note;
+                }
+                break;
+            }
+            case RentalEventType::STARTED: {
+                RentalRequest& request = requests.at(event.id);
+                request.status = RentalStatus::ACTIVE;
+                request.resourceId = event.resourceId;
+                rentals.insert_or_assign(event.rentalId, RentalRecord(event.rentalId, event.id, request.userId,
+                                                                      event.resourceId, event.time));
+                break;
+            }
+            case RentalEventType::FINISHED: {
+                RentalRecord& record = rentals.at(event.id);
+                record.status = event.status;
+                record.actualEndTime = event.time;
+                record.totalCost = fromMinorUnits(event.cost);
+                auto request = requests.find(record.requestId);
+                if (request != requests.end()) {
+                    request->second.status = event.status;
+                }
+                break;
+            }
+        }
+    }
+
+    // 打开日志并校验文件头，返回文件大小；文件不存在、为空或文件头写入中断（不足8字节）时返回0
+    static uint64_t openForScan(const std::string& filename, std::ifstream& file) {
+        file.open(filename, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return 0;
+        }
+        uint64_t size = static_cast<uint64_t>(file.tellg());
+        if (size < kFileHeaderSize) {
+            return 0;
+        }
+        char header[kFileHeaderSize];
+        file.seekg(0);
+        if (!file.read(header, kFileHeaderSize) ||
+            !std::equal(kLogMagic, kLogMagic + 4, header)) {
+            throw std::runtime_error("租赁日志格式错误: " + filename);
+        }
+        return size;
+    }
+
+    // 日志中第一条事件的序号，没有完整的第一条记录时返回0（序号从1开始）
+    static uint64_t firstSequence(const std::string& filename) {
+        std::ifstream file;
+        uint64_t size = openForScan(filename, file);
+        char head[kEntryHeaderSize + sizeof(uint64_t)];
+        if (size < kFileHeaderSize + sizeof(head) || !file.read(head, sizeof(head))) {
+            return 0;
+        }
+        uint64_t sequence;
+        std::memcpy(&sequence, head + kEntryHeaderSize, sizeof(sequence));
+        return sequence;
+    }
+
+    // 从 offset 处直接定位，逐条解码其后的完整记录，返回完整记录的结束位置；文件不存在或为空时返回0
+    template <typename Visitor>
+    uint64_t scan(const std::string& filename, uint64_t offset, Visitor visit) const {
+        std::ifstream file;
+        uint64_t size = openForScan(filename, file);
+        if (size == 0) {
+            return 0;
+        }
+        if (offset > size) {
+            throw std::runtime_error("租赁日志短于快照记录的位置: " + filename);
+        }
+        uint64_t begin = std::max<uint64_t>(kFileHeaderSize, offset);
+        std::vector<char> data(static_cast<size_t>(size - begin));
+        file.seekg(static_cast<std::streamoff>(begin));
+        file.read(data.data(), static_cast<std::streamsize>(data.size()));
+        data.resize(static_cast<size_t>(file.gcount()));
+        size_t pos = 0;
+        while (data.size() - pos >= kEntryHeaderSize) {
+            uint32_t length, checksum;
+            std::memcpy(&length, data.data() + pos, sizeof(length));
+            std::memcpy(&checksum, data.data() + pos + 4, sizeof(checksum));
+            if (data.size() - pos - kEntryHeaderSize < length) {
+                break;
+            }
+            const char* body = data.data() + pos + kEntryHeaderSize;
+            if (static_cast<uint32_t>(payloadChecksum(body, length)) != checksum) {
+                break;
+            }
+            BinaryReader reader(body, length);
+            visit(decode(reader));
+            pos += kEntryHeaderSize + length;
+        }
+        return begin + pos;
+    }
+
+    // 分段文件名：最后序号补齐到20位，按文件名排序即按时间排序
+    std::string segmentFile(uint64_t sequence) const {
+        std::string digits = std::to_string(sequence);
+        return logFile + "." + std::string(20 - digits.size(), '0') + digits;
+    }
+
+    // 把当前日志改名为分段，之后的事件写入新日志；分段已存在时不覆盖
+    void rotateLog() {
+        log.close();
+        std::string segment = segmentFile(lastSequence);
+        if (std::filesystem::exists(segment)) {
+            throw std::runtime_error("租赁日志分段已存在: " + segment);
+        }
+        replaceFileDurably(logFile, segment);
+        openLog();
+    }
+
+    RentalRequest& pendingRequest(const std::string& requestId) {
+        auto it = requests.find(requestId);
+        if (it == requests.end()) {
+            throw std::runtime_error("租赁请求不存在: " + requestId);
+        }
+        return it->second;
+    }
+
+    static void checkTransition(const std::string& id, RentalStatus from, RentalStatus to) {
+        if (!canTransition(from, to)) {
+            throw std::runtime_error("不允许的租赁状态转换: " + id + " " + std::to_string(static_cast<int>(from)) +
+                                     " -> " + std::to_string(static_cast<int>(to)));
+        }
+    }
+
+public:
+    explicit RentalEventLog(std::string snapshot = "rentals.dat", std::string logPath = "rentals.log")
+        : snapshotFile(std::move(snapshot)), logFile(std::move(logPath)) {}
+
+    RentalEventLog(const RentalEventLog&) = delete;
+    RentalEventLog& operator=(const RentalEventLog&) = delete;
+
+    // 读取快照并重放其后的事件；没有快照时重放全部分段和当前日志，都不存在时从空状态开始
+    void load() {
+        log.close();
+        requests.clear();
+        rentals.clear();
+        lastSequence = 0;
+        uint64_t offset = 0;
+        if (std::filesystem::exists(snapshotFile)) {
+            std::vector<char> data;
+            BinaryFileHeader header;
+            if (!readBinaryFile(snapshotFile, kSnapshotMagic, data, header)) {
+                throw std::runtime_error("租赁快照格式错误: " + snapshotFile);
+            }
+            BinaryReader reader(data.data() + kBinaryHeaderSize, header.payloadSize);
+            lastSequence = reader.get<uint64_t>();
+            offset = reader.get<uint64_t>();
+            uint64_t requestCount = reader.get<uint64_t>();
+            requests.reserve(requestCount);
+            for (uint64_t i = 0; i < requestCount; ++i) {
+                std::string id = reader.getString();
+                std::string userId = reader.getString();
+                std::string resourceId = reader.getString();
+                RentalRequest request(id, userId, resourceId, fromTicks(reader.get<int64_t>()),
+                                      std::chrono::hours(reader.get<int64_t>()));
+                request.requestTime = fromTicks(reader.get<int64_t>());
+                request.status = static_cast<RentalStatus>(reader.get<uint8_t>());
+                request.adminNotes = reader.getString();
+                requests.emplace(std::move(id), std::move(request));
+            }
+            rentals.reserve(header.recordCount);
+            for (uint64_t i = 0; i < header.recordCount; ++i) {
+                std::string rentalId = reader.getString();
+                std::string requestId = reader.getString();
+                std::string userId = reader.getString();
+                std::string resourceId = reader.getString();
+                RentalRecord record(rentalId, requestId, userId, resourceId, fromTicks(reader.get<int64_t>()));
+                record.actualEndTime = fromTicks(reader.get<int64_t>());
+                record.totalCost = fromMinorUnits(reader.get<Money>());
+                record.status = static_cast<RentalStatus>(reader.get<uint8_t>());
+                rentals.emplace(std::move(rentalId), std::move(record));
+            }
+        }
+        uint64_t snapshotSequence = lastSequence;
+        eventsSinceSnapshot = 0;
+        snapshotError = nullptr;
+        if (!std::filesystem::exists(snapshotFile)) {
+            // 没有快照时从各分段开始完整重放
+            for (const std::string& segment : getSegments()) {
+                scan(segment, 0, [this](const RentalEvent& event) {
+                    apply(event);
+                    ++eventsSinceSnapshot;
+                });
+            }
+        }
+        if (std::filesystem::exists(logFile)) {
+            // 快照之后已换了新日志（第一条事件晚于快照），快照中的偏移指向旧日志，从头重放
+            uint64_t first = firstSequence(logFile);
+            if (first == 0 || first > snapshotSequence) {
+                offset = kFileHeaderSize;
+            }
+            uint64_t valid = scan(logFile, offset, [this, snapshotSequence](const RentalEvent& event) {
+                if (event.sequence > snapshotSequence) {
+                    apply(event);
+                    ++eventsSinceSnapshot;
+                }
+            });
+            // 截断末尾不完整的记录；文件头写入中断时 valid 为0，整个截断后由 openLog() 重写文件头
+            uint64_t size = std::filesystem::file_size(logFile);
+            if (valid < size && (valid != 0 || size < kFileHeaderSize)) {
+                std::filesystem::resize_file(logFile, valid);
+            }
+        }
+        openLog();
+    }
+
+    // 写快照：当前状态 + 对应的日志位置，先写临时文件再改名；成功后换新的日志分段
+    void snapshot() {
+        if (log.is_open()) {
+            log.flush();
+        }
+        BinaryWriter writer(64 + requests.size() * 96 + rentals.size() * 96);
+        writer.put(lastSequence);
+        writer.put(logBytes);
+        writer.put(static_cast<uint64_t>(requests.size()));
+        for (const auto& entry : requests) {
+            const RentalRequest& request = entry.second;
+            writer.putString(request.requestId);
+            writer.putString(request.userId);
+            writer.putString(request.resourceId);
+            writer.put(ticks(request.desiredStartTime));
+            writer.put(static_cast<int64_t>(request.durationHours.count()));
+            writer.put(ticks(request.requestTime));
+            writer.put(static_cast<uint8_t>(request.status));
+            writer.putString(request.adminNotes);
+        }
+        for (const auto& entry : rentals) {
+            const RentalRecord& record = entry.second;
+            writer.putString(record.rentalId);
+            writer.putString(record.requestId);
+            writer.putString(record.userId);
+            writer.putString(record.resourceId);
+            writer.put(ticks(record.actualStartTime));
+            writer.put(ticks(record.actualEndTime));
+            writer.put(toMinorUnits(record.totalCost));
+            writer.put(static_cast<uint8_t>(record.status));
+        }
+        std::string tmp = snapshotFile + ".tmp";
+        writer.writeToFile(tmp, kSnapshotMagic, rentals.size());
+        replaceFileDurably(tmp, snapshotFile);
+        eventsSinceSnapshot = 0;
+        if (logBytes > kFileHeaderSize) {
+            rotateLog();
+        }
+    }
+
+    // 提交新的待审批请求
+    void submit(const RentalRequest& request) {
+        if (requests.count(request.requestId)) {
+            throw std::runtime_error("租赁请求ID已存在: " + request.requestId);
+        }
+        BinaryWriter writer = beginEvent(RentalEventType::REQUESTED, request.requestTime);
+        writer.putString(request.requestId);
+        writer.putString(request.userId);
+        writer.putString(request.resourceId);
+        writer.put(ticks(request.desiredStartTime));
+        writer.put(static_cast<int64_t>(request.durationHours.count()));
+        commit(writer);
+    }
+
+    // 审批、拒绝、取消、过期等请求状态变更
+    void transition(const std::string& requestId, RentalStatus status, const std::string& note = "",
+                    Clock::time_point time = Clock::now()) {
+        RentalRequest& request = pendingRequest(requestId);
+        if (status == RentalStatus::ACTIVE || status == RentalStatus::COMPLETED ||
+            request.status == RentalStatus::ACTIVE) {
+            throw std::runtime_error("租赁开始和结束须通过 start/finish 记录: " + requestId);
+        }
+        checkTransition(requestId, request.status, status);
+        BinaryWriter writer = beginEvent(RentalEventType::TRANSITION, time);
+        writer.putString(requestId);
+        writer.put(static_cast<uint8_t>(status));
+        writer.putString(note);
+        commit(writer);
+    }
+
+    // 已批准的请求开始租赁，生成租赁记录；resourceId 为空时沿用请求中的资源
+    const RentalRecord& start(const std::string& requestId, const std::string& rentalId,
+                              Clock::time_point time = Clock::now(), const std::string& resourceId = "") {
+        RentalRequest& request = pendingRequest(requestId);
+        checkTransition(requestId, request.status, RentalStatus::ACTIVE);
+        if (rentals.count(rentalId)) {
+            throw std::runtime_error("租赁ID已存在: " + rentalId);
+        }
+        BinaryWriter writer = beginEvent(RentalEventType::STARTED, time);
+        writer.putString(requestId);
+        writer.putString(rentalId);
+        writer.putString(resourceId.empty() ? request.resourceId : resourceId);
+        commit(writer);
+        return rentals.at(rentalId);
+    }
+
+    // 结束租赁（COMPLETED）或中途取消（CANCELLED），记录费用
+    void finish(const std::string& rentalId, double cost, RentalStatus status = RentalStatus::COMPLETED,
+                Clock::time_point time = Clock::now()) {
+        auto it = rentals.find(rentalId);
+        if (it == rentals.end()) {
+            throw std::runtime_error("租赁记录不存在: " + rentalId);
+        }
+        checkTransition(rentalId, it->second.status, status);
+        BinaryWriter writer = beginEvent(RentalEventType::FINISHED, time);
+        writer.putString(rentalId);
+        writer.put(static_cast<uint8_t>(status));
+        writer.put(toMinorUnits(cost));
+        commit(writer);
+    }
+
+    // 已归档的日志分段，按时间先后
+    std::vector<std::string> getSegments() const {
+        std::filesystem::path path(logFile);
+        std::filesystem::path dir = path.parent_path().empty() ? std::filesystem::path(".") : path.parent_path();
+        std::string prefix = path.filename().string() + ".";
+        std::vector<std::string> segments;
+        if (!std::filesystem::exists(dir)) {
+            return segments;
+        }
+        for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+            std::string name = entry.path().filename().string();
+            if (name.size() == prefix.size() + 20 && name.compare(0, prefix.size(), prefix) == 0 &&
+                std::all_of(name.begin() + prefix.size(), name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                segments.push_back((path.parent_path() / name).string());
+            }
+        }
+        std::sort(segments.begin(), segments.end());
+        return segments;
+    }
+
+    // 审计：按顺序遍历各分段和当前日志中的全部事件，回调参数为 const RentalEvent&
+    template <typename Visitor>
+    void forEachEvent(Visitor visit) {
+        log.flush();
+        for (const std::string& segment : getSegments()) {
+            scan(segment, 0, visit);
+        }
+        scan(logFile, 0, visit);
+    }
+
+    const RentalRequest* findRequest(const std::string& requestId) const {
+        auto it = requests.find(requestId);
+        return it == requests.end() ? nullptr : &it->second;
+    }
+
+    const RentalRecord* findRental(const std::string& rentalId) const {
+        auto it = rentals.find(rentalId);
+        return it == rentals.end() ? nullptr : &it->second;
+    }
+
+    const std::unordered_map<std::string, RentalRequest>& getRequests() const { return requests; }
+    const std::unordered_map<std::string, RentalRecord>& getRentals() const { return rentals; }
+    uint64_t getLastSequence() const { return lastSequence; }
+    uint64_t getLogBytes() const { return logBytes; }
+    // 自动快照失败时返回其错误，供所有者记录或改为显式调用 snapshot()
+    std::exception_ptr getSnapshotError() const { return snapshotError; }
+};
+
+#endif // RENTAL_LOG_HPP
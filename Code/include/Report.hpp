@@ -0,0 +1,127 @@
+// Report.hpp
+#ifndef REPORT_HPP
+#define REPORT_HPP
+
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include "ReportBuffer.hpp"
+#include "Resource.hpp"
+#include "User.hpp"
+
+/**
+ * @class ReportRenderer
+ * @brief 管理员列表报表：分页，支持逐条文本、CSV、TSV 三种格式。
+ *
+ * 一页内容全部格式化到一个 ReportBuffer 中再一次写出。
+ * CSV/TSV 第一行为表头，CPU/GPU 特有的列对另一类资源留空。
+ */
+class ReportRenderer {
+public:
+    static constexpr size_t kAll = std::numeric_limits<size_t>::max();
+
+    // 资源报表：从第 offset 条起最多 limit 条，返回写入的条数
+    static size_t renderResources(const ResourceCollection& collection, ReportFormat format, ReportBuffer& out,
+                                  size_t offset = 0, size_t limit = kAll) {
+        const char* sep = ReportBuffer::separator(format);
+        if (format == ReportFormat::TEXT) {
+            out << "===== 所有资源列表 =====\n";
+        } else {
+            out << "id" << sep << "name" << sep << "type" << sep << "status" << sep << "hourly_rate" << sep
+                << "storage" << sep << "core_count" << sep << "frequency" << sep << "cuda_cores" << sep << "vram\n";
+        }
+        size_t written = 0;
+        collection.forEachResourceInRange(offset, limit, [&](const Resource& resource) {
+            ++written;
+            if (format == ReportFormat::TEXT) {
+                resource.appendDetails(out);
+                out << "------------------------\n";
+                return;
+            }
+            bool cpu = resource.getResourceType() == ResourceType::CPU;
+            out.field(resource.getResourceId(), format) << sep;
+            out.field(resource.getResourceName(), format) << sep;
+            out << (cpu ? "CPU" : "GPU") << sep;
+            out << (resource.isAvailable() ? "IDLE" : "IN_USE") << sep;
+            out << resource.getHourlyRate() << sep << resource.getStorage();
+            const ResourceAttribute extra[] = {ResourceAttribute::CORE_COUNT, ResourceAttribute::FREQUENCY,
+                                               ResourceAttribute::CUDA_CORES, ResourceAttribute::VRAM};
+            for (ResourceAttribute attribute : extra) {
+                double value;
+                out << sep;
+                if (resource.getAttribute(attribute, value)) {
+                    out << value;
+                }
+            }
+            out << '\n';
+        });
+        return written;
+    }
+
+    // 用户报表：从第 offset 条起最多 limit 条，返回写入的条数
+    static size_t renderUsers(const UserCollection& users, ReportFormat format, ReportBuffer& out,
+                              size_t offset = 0, size_t limit = kAll) {
+        const char* sep = ReportBuffer::separator(format);
+        if (format == ReportFormat::TEXT) {
+            out << "===== 所有用户列表 =====\n";
+        } else {
+            out << "id" << sep << "username" << sep << "role" << sep << "status" << sep << "balance\n";
+        }
+        size_t written = 0;
+        users.forEachUserInRange(offset, limit, [&](const User& user) {
+            ++written;
+            if (format == ReportFormat::TEXT) {
+                UserCollection::appendUserDetails(out, user);
+                return;
+            }
+            out.field(user.getUserId(), format) << sep;
+            out.field(user.getUsername(), format) << sep;
+            out << UserRoleToString(user.getRole()) << sep;
+            out << UserStatusToString(user.getStatus()) << sep;
+            out << user.getAccountBalance() << '\n';
+        });
+        return written;
+    }
+
+    // 输出资源报表的第 page 页（从0开始），TEXT 格式在末尾附页码
+    static void printResourcePage(const ResourceCollection& collection, size_t page, size_t pageSize,
+                                  ReportFormat format = ReportFormat::TEXT, std::ostream& os = std::cout) {
+        size_t rows = pageRows(page, pageSize, collection.size());
+        ReportBuffer out(rows * 200 + 128);
+        renderResources(collection, format, out, rows ? page * pageSize : collection.size(), rows);
+        appendPageFooter(out, format, page, pageSize, collection.size());
+        out.writeTo(os);
+    }
+
+    // 输出用户报表的第 page 页（从0开始）
+    static void printUserPage(const UserCollection& users, size_t page, size_t pageSize,
+                              ReportFormat format = ReportFormat::TEXT, std::ostream& os = std::cout) {
+        size_t rows = pageRows(page, pageSize, users.size());
+        ReportBuffer out(rows * 128 + 128);
+        renderUsers(users, format, out, rows ? page * pageSize : users.size(), rows);
+        appendPageFooter(out, format, page, pageSize, users.size());
+        out.writeTo(os);
+    }
+
+private:
+    // 第 page 页实际的条数，超出末页为0；pageSize 为 kAll 时不会溢出
+    static size_t pageRows(size_t page, size_t pageSize, size_t total) {
+        if (pageSize == 0 || (page != 0 && pageSize > total / page)) {
+            return 0;
+        }
+        size_t offset = page * pageSize;
+        return offset >= total ? 0 : std::min(pageSize, total - offset);
+    }
+
+    static void appendPageFooter(ReportBuffer& out, ReportFormat format, size_t page, size_t pageSize,
+                                 size_t total) {
+        if (format != ReportFormat::TEXT || pageSize == 0) {
+            return;
+        }
+        size_t pages = (total + pageSize - 1) / pageSize;
+        out << "第 " << page + 1 << "/" << (pages == 0 ? 1 : pages) << " 页，共 " << total << " 条\n";
+    }
+};
+
+#endif // REPORT_HPP
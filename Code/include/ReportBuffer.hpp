@@ -0,0 +1,112 @@
+// ReportBuffer.hpp
+#ifndef REPORT_BUFFER_HPP
+#define REPORT_BUFFER_HPP
+
+#include <string>
+#include <cstdint>
+#include <charconv>
+#include <ostream>
+
+// 报表输出格式
+enum class ReportFormat {
+    TEXT, // 与 displayDetails 相同的逐条文本
+    CSV,
+    TSV
+};
+
+/**
+ * @class ReportBuffer
+ * @brief 报表输出缓冲区。
+ *
+ * 所有内容先格式化到一块预分配的连续内存中，最后以一次 write 输出，
+ * 代替逐字段的 std::cout <<。数值格式化使用 std::to_chars，不经过流和区域设置，
+ * 浮点数按 %g（6位有效数字）输出，与 std::cout 默认格式一致。
+ */
+class ReportBuffer {
+private:
+    std::string buffer;
+
+public:
+    explicit ReportBuffer(size_t reserveBytes = 1 << 16) { buffer.reserve(reserveBytes); }
+
+    ReportBuffer& operator<<(const std::string& value) {
+        buffer.append(value);
+        return *this;
+    }
+
+    ReportBuffer& operator<<(const char* value) {
+        buffer.append(value);
+        return *this;
+    }
+
+    ReportBuffer& operator<<(char value) {
+        buffer.push_back(value);
+        return *this;
+    }
+
+    ReportBuffer& operator<<(int value) { return appendInteger(static_cast<long long>(value)); }
+    ReportBuffer& operator<<(long value) { return appendInteger(static_cast<long long>(value)); }
+    ReportBuffer& operator<<(long long value) { return appendInteger(value); }
+    ReportBuffer& operator<<(unsigned value) { return appendInteger(static_cast<unsigned long long>(value)); }
+    ReportBuffer& operator<<(unsigned long value) { return appendInteger(static_cast<unsigned long long>(value)); }
+    ReportBuffer& operator<<(unsigned long long value) { return appendInteger(value); }
+
+    ReportBuffer& operator<<(double value) {
+        char digits[32];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+        buffer.append(digits, result.ptr);
+        return *this;
+    }
+
+    template <typename Integer>
+    ReportBuffer& appendInteger(Integer value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        buffer.append(digits, result.ptr);
+        return *this;
+    }
+
+    // 按格式写入一个表格字段：CSV 在需要时加引号并转义，TSV 把制表符和换行替换为空格
+    ReportBuffer& field(const std::string& value, ReportFormat format) {
+        if (format == ReportFormat::CSV && value.find_first_of(",\"\r\n") != std::string::npos) {
+            buffer.push_back('"');
+            for (char c : value) {
+                if (c == '"') {
+                    buffer.push_back('"');
+                }
+                buffer.push_back(c);
+            }
+            buffer.push_back('"');
+        } else if (format == ReportFormat::TSV && value.find_first_of("\t\r\n") != std::string::npos) {
+            for (char c : value) {
+                buffer.push_back(c == '\t' || c == '\r' || c == '\n' ? ' ' : c);
+            }
+        } else {
+            buffer.append(value);
+        }
+        return *this;
+    }
+
+    // 字段分隔符（TEXT 格式用两个空格）
+    static const char* separator(ReportFormat format) {
+        switch (format) {
+            case ReportFormat::CSV: return ",";
+            case ReportFormat::TSV: return "\t";
+            default: return "  ";
+        }
+    }
+
+    size_t size() const { return buffer.size(); }
+    bool empty() const { return buffer.empty(); }
+    const std::string& str() const { return buffer; }
+    void clear() { buffer.clear(); }
+
+    // 一次写出全部内容并清空缓冲区
+    void writeTo(std::ostream& os) {
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        os.flush();
+        buffer.clear();
+    }
+};
+
+#endif // REPORT_BUFFER_HPP
@@ -0,0 +1,264 @@
+// ReservationCalendar.hpp
+#ifndef RESERVATION_CALENDAR_HPP
+#define RESERVATION_CALENDAR_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+#include "Rental.hpp"
+#include "Resource.hpp"
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+// 时间区间 [start, end)
+struct TimeInterval {
+    TimePoint start;
+    TimePoint end;
+};
+
+/**
+ * @class ReservationCalendar
+ * @brief 单个资源的预约日历。
+ *
+ * 同一资源的预约互不重叠，按开始时间存放在有序映射中，
+ * 与新区间冲突的只可能是开始时间不晚于它的最后一个预约及其后继，
+ * 因此冲突检查为 O(log n)，查找最早空闲时段为 O(log n + 经过的预约数)。
+ */
+class ReservationCalendar {
+public:
+    struct Booking {
+        TimePoint end;
+        std::string requestId;
+    };
+
+private:
+    std::map<TimePoint, Booking> bookings; // 开始时间 -> 预约
+
+    // 第一个可能与 [start, ...) 相交的预约
+    std::map<TimePoint, Booking>::const_iterator firstTouching(TimePoint start) const {
+        auto it = bookings.upper_bound(start);
+        if (it != bookings.begin()) {
+            auto prev = std::prev(it);
+            if (prev->second.end > start) {
+                return prev;
+            }
+        }
+        return it;
+    }
+
+public:
+    bool isFree(TimePoint start, TimePoint end) const {
+        auto it = firstTouching(start);
+        return it == bookings.end() || it->first >= end;
+    }
+
+    // 预约 [start, end)，与已有预约冲突或区间为空时返回false
+    bool reserve(const std::string& requestId, TimePoint start, TimePoint end) {
+        if (end <= start || !isFree(start, end)) {
+            return false;
+        }
+        bookings.emplace(start, Booking{end, requestId});
+        return true;
+    }
+
+    bool cancel(TimePoint start) { return bookings.erase(start) != 0; }
+
+    // 不早于 notBefore 的最早一段长为 duration 的空闲时段的开始时间
+    TimePoint earliestFreeSlot(TimePoint notBefore, std::chrono::system_clock::duration duration) const {
+        TimePoint candidate = notBefore;
+        for (auto it = firstTouching(notBefore); it != bookings.end(); ++it) {
+            if (it->first >= candidate + duration) {
+                break;
+            }
+            if (it->second.end > candidate) {
+                candidate = it->second.end;
+            }
+        }
+        return candidate;
+    }
+
+    // 窗口 [from, to) 内的空闲区间
+    std::vector<TimeInterval> freeIntervals(TimePoint from, TimePoint to) const {
+        std::vector<TimeInterval> result;
+        TimePoint cursor = from;
+        for (auto it = firstTouching(from); it != bookings.end() && it->first < to; ++it) {
+            if (it->first > cursor) {
+                result.push_back(TimeInterval{cursor, it->first});
+            }
+            if (it->second.end > cursor) {
+                cursor = it->second.end;
+            }
+        }
+        if (cursor < to) {
+            result.push_back(TimeInterval{cursor, to});
+        }
+        return result;
+    }
+
+    // 删除在 now 之前已结束的预约，返回删除数量
+    size_t pruneBefore(TimePoint now) {
+        size_t count = 0;
+        for (auto it = bookings.begin(); it != bookings.end() && it->first < now;) {
+            if (it->second.end <= now) {
+                it = bookings.erase(it);
+                ++count;
+            } else {
+                ++it;
+            }
+        }
+        return count;
+    }
+
+    size_t size() const { return bookings.size(); }
+    const std::map<TimePoint, Booking>& getBookings() const { return bookings; }
+};
+
+/**
+ * @class ReservationBook
+ * @brief 所有资源的预约日历。
+ *
+ * 每个资源一个 ReservationCalendar，另按请求ID索引预约位置以便取消。
+ * 用于租赁请求的冲突检测和未来时段的预订，校验代价与请求积压量无关。
+ */
+class ReservationBook {
+private:
+    struct Location {
+        std::string resourceId;
+        TimePoint start;
+    };
+
+    std::unordered_map<std::string, ReservationCalendar> calendars; // 资源ID -> 日历
+    std::unordered_map<std::string, Location> byRequest;            // 请求ID -> 预约位置
+
+    const ReservationCalendar* calendarOf(const std::string& resourceId) const {
+        auto it = calendars.find(resourceId);
+        return it == calendars.end() ? nullptr : &it->second;
+    }
+
+public:
+    // 预约资源，冲突、区间为空或请求ID已存在时返回false
+    // 只在预约成功时为资源建立日历，失败的请求（如资源ID有误）不留下空日历
+    bool reserve(const std::string& requestId, const std::string& resourceId, TimePoint start, TimePoint end) {
+        if (byRequest.count(requestId)) {
+            return false;
+        }
+        auto it = calendars.find(resourceId);
+        if (it != calendars.end()) {
+            if (!it->second.reserve(requestId, start, end)) {
+                return false;
+            }
+        } else if (end <= start ||
+                   !calendars.try_emplace(resourceId).first->second.reserve(requestId, start, end)) {
+            return false;
+        }
+        byRequest.emplace(requestId, Location{resourceId, start});
+        return true;
+    }
+
+    // 按租赁请求预约
+    bool reserve(const RentalRequest& request) {
+        return reserve(request.requestId, request.resourceId, request.desiredStartTime,
+                       request.desiredStartTime + request.durationHours);
+    }
+
+    bool cancel(const std::string& requestId) {
+        auto it = byRequest.find(requestId);
+        if (it == byRequest.end()) {
+            return false;
+        }
+        auto calendar = calendars.find(it->second.resourceId);
+        if (calendar != calendars.end()) {
+            calendar->second.cancel(it->second.start);
+            if (calendar->second.size() == 0) {
+                calendars.erase(calendar);
+            }
+        }
+        byRequest.erase(it);
+        return true;
+    }
+
+    bool isFree(const std::string& resourceId, TimePoint start, TimePoint end) const {
+        const ReservationCalendar* calendar = calendarOf(resourceId);
+        return !calendar || calendar->isFree(start, end);
+    }
+
+    // 请求的时段是否与该资源已有预约冲突
+    bool conflicts(const RentalRequest& request) const {
+        return !isFree(request.resourceId, request.desiredStartTime,
+                       request.desiredStartTime + request.durationHours);
+    }
+
+    TimePoint earliestFreeSlot(const std::string& resourceId, TimePoint notBefore,
+                               std::chrono::system_clock::duration duration) const {
+        const ReservationCalendar* calendar = calendarOf(resourceId);
+        return calendar ? calendar->earliestFreeSlot(notBefore, duration) : notBefore;
+    }
+
+    std::vector<TimeInterval> freeIntervals(const std::string& resourceId, TimePoint from, TimePoint to) const {
+        const ReservationCalendar* calendar = calendarOf(resourceId);
+        return calendar ? calendar->freeIntervals(from, to) : std::vector<TimeInterval>{TimeInterval{from, to}};
+    }
+
+    // 批量查询：某类型中在 [start, end) 整段空闲的资源
+    std::vector<std::shared_ptr<Resource>> availableResources(const ResourceCollection& collection, ResourceType type,
+                                                              TimePoint start, TimePoint end) const {
+        std::vector<std::shared_ptr<Resource>> result;
+        collection.forEachSharedByType(type, [&](const std::shared_ptr<Resource>& resource) {
+            if (isFree(resource->getResourceId(), start, end)) {
+                result.push_back(resource);
+            }
+        });
+        return result;
+    }
+
+    // 某类型中最早能容纳 duration 的资源及开始时间，没有该类型资源时返回空
+    std::optional<std::pair<std::shared_ptr<Resource>, TimePoint>> earliestAvailable(
+        const ResourceCollection& collection, ResourceType type, TimePoint notBefore,
+        std::chrono::system_clock::duration duration) const {
+        const std::shared_ptr<Resource>* bestResource = nullptr;
+        TimePoint bestSlot;
+        collection.forEachSharedByType(type, [&](const std::shared_ptr<Resource>& resource) {
+            if (bestResource && bestSlot == notBefore) {
+                return; // 已找到立即可用的资源
+            }
+            TimePoint slot = earliestFreeSlot(resource->getResourceId(), notBefore, duration);
+            if (!bestResource || slot < bestSlot) {
+                bestResource = &resource;
+                bestSlot = slot;
+            }
+        });
+        if (!bestResource) {
+            return std::nullopt;
+        }
+        return std::make_pair(*bestResource, bestSlot);
+    }
+
+    // 删除所有在 now 之前已结束的预约，预约删空的资源日历一并删除
+    size_t pruneBefore(TimePoint now) {
+        size_t count = 0;
+        for (auto it = calendars.begin(); it != calendars.end();) {
+            for (const auto& booking : it->second.getBookings()) {
+                if (booking.first >= now) {
+                    break;
+                }
+                if (booking.second.end <= now) {
+                    byRequest.erase(booking.second.requestId);
+                }
+            }
+            count += it->second.pruneBefore(now);
+            if (it->second.size() == 0) {
+                it = calendars.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return count;
+    }
+
+    size_t size() const { return byRequest.size(); }
+};
+
+#endif // RESERVATION_CALENDAR_HPP
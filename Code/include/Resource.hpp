@@ -8,6 +8,18 @@
 #include <map> // 用于资源参数
 #include <memory> // 智能指针
 #include <fstream> // 用于文件操作
+#include <unordered_map> // 资源ID哈希索引
+#include <stdexcept>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+#include <atomic>
+#include <mutex>
+#include "BinaryFormat.hpp"
+#include "ResourceSlotMap.hpp"
+#include "LazyCatalog.hpp"
+#include "ReportBuffer.hpp"
 
 // 资源类型枚举
 enum class ResourceType {
@@ -15,6 +27,7 @@ enum class ResourceType {
     GPU,
     // 根据需要添加其他类型
 };
+constexpr size_t kResourceTypeCount = 2;
 
 // 资源状态枚举
 enum class ResourceStatus {
@@ -22,6 +35,46 @@ enum class ResourceStatus {
     IN_USE,
 };
 
+// 可用于范围筛选和排序的资源属性
+enum class ResourceAttribute {
+    HOURLY_RATE, // 所有资源
+    STORAGE,     // 所有资源
+    CORE_COUNT,  // CPU
+    FREQUENCY,   // CPU
+    CUDA_CORES,  // GPU
+    VRAM,        // GPU
+};
+constexpr size_t kResourceAttributeCount = 6;
+
+class Resource;
+
+/**
+ * @class ResourceListener
+ * @brief 资源变更的监听接口。
+ *
+ * 资源被加入集合后由集合注册为监听者，
+ * 状态或价格改变时回调，以便集合同步更新其索引。
+ */
+class ResourceListener {
+public:
+    virtual ~ResourceListener() = default;
+    virtual void onStatusChanged(Resource& resource, ResourceStatus oldStatus) = 0;
+    virtual void onRateChanged(Resource& resource, double oldRate) = 0;
+};
+
+/**
+ * @class ResourceStatusObserver
+ * @brief 集合中资源状态变更的观察者接口。
+ *
+ * 由 ResourceCollection::addStatusObserver 注册，集合更新完自身索引后回调，
+ * 用于变更日志、浏览目录等需要跟随资源状态的模块；回调中不得抛出异常。
+ */
+class ResourceStatusObserver {
+public:
+    virtual ~ResourceStatusObserver() = default;
+    virtual void onResourceStatusChanged(const Resource& resource, ResourceStatus oldStatus) = 0;
+};
+
 /**
  * @class Resource
  * @brief 系统中所有计算资源的基类。
@@ -40,6 +93,7 @@ protected:
     ResourceStatus status;
     double Storage;
     double hourprice;
+    ResourceListener* listener = nullptr; // 所属集合，不参与序列化
     
 public:
     // 构造函数 - 修改参数名保持一致性
@@ -61,15 +115,46 @@ public:
     // std::string getParameter(const std::string& paramName) const{return parameters.at(paramName);} // 获取特定参数
     // const std::map<std::string, std::string>& getAllParameters() const{return parameters;}
     double getHourlyRate() const{return hourprice;}
+    double getStorage() const{return Storage;}
+
+    // 读取可筛选属性，资源不具备该属性时返回false
+    virtual bool getAttribute(ResourceAttribute attribute, double& value) const {
+        switch (attribute) {
+            case ResourceAttribute::HOURLY_RATE: value = hourprice; return true;
+            case ResourceAttribute::STORAGE: value = Storage; return true;
+            default: return false;
+        }
+    }
 
     // 设置器
     void setResourceName(const std::string& newName){resourceName=newName;}
-    void setStatus(ResourceStatus newStatus){status=newStatus;}
+    void setStatus(ResourceStatus newStatus){
+        if (newStatus == status) return;
+        ResourceStatus oldStatus = status;
+        status = newStatus;
+        if (listener) listener->onStatusChanged(*this, oldStatus);
+    }
+    void setListener(ResourceListener* newListener){listener=newListener;}
     // void setParameter(const std::string& paramName, const std::string& value){parameters[paramName]=value;} // 设置或更新参数
-    void setHourlyRate(double newRate){hourprice=newRate;}
+    void setHourlyRate(double newRate){
+        if (newRate == hourprice) return;
+        double oldRate = hourprice;
+        hourprice = newRate;
+        if (listener) listener->onRateChanged(*this, oldRate);
+    }
+
+    // 把资源详情格式化到报表缓冲区
+    virtual void appendDetails(ReportBuffer& out) const = 0;
+
+    // 显示资源详情
+    void displayDetails() const {
+        ReportBuffer out(512);
+        appendDetails(out);
+        out.writeTo(std::cout);
+    }
 
-    // 显示资源特定详情的虚函数
-    virtual void displayDetails() const = 0;
+    // 复制资源（副本不属于任何集合）
+    virtual std::shared_ptr<Resource> clone() const = 0;
 
     // 检查资源是否可供租用
     bool isAvailable() const{return status==ResourceStatus::IDLE;}
@@ -87,18 +172,31 @@ public:
     
     virtual void deserialize(std::istream& is) {
         // 读取基本属性
-        char buffer[256];
-        is.getline(buffer, 256, '\0');
-        resourceId = buffer;
-        
-        is.getline(buffer, 256, '\0');
-        resourceName = buffer;
+        std::getline(is, resourceId, '\0');
+        std::getline(is, resourceName, '\0');
         
         is.read(reinterpret_cast<char*>(&type), sizeof(ResourceType));
         is.read(reinterpret_cast<char*>(&status), sizeof(ResourceStatus));
         is.read(reinterpret_cast<char*>(&Storage), sizeof(double));
         is.read(reinterpret_cast<char*>(&hourprice), sizeof(double));
     }
+
+    // v2 格式：定长字段在前，字符串带长度前缀
+    virtual void serialize(BinaryWriter& writer) const {
+        writer.put(static_cast<uint8_t>(status));
+        writer.put(Storage);
+        writer.put(hourprice);
+        writer.putString(resourceId);
+        writer.putString(resourceName);
+    }
+
+    virtual void deserialize(BinaryReader& reader) {
+        status = static_cast<ResourceStatus>(reader.get<uint8_t>());
+        Storage = reader.get<double>();
+        hourprice = reader.get<double>();
+        resourceId = reader.getString();
+        resourceName = reader.getString();
+    }
 };
 
 /**
@@ -114,20 +212,32 @@ private:
 public:
     CPUResource(std::string id, std::string name, double rate ,int cores, double frequency,ResourceType t=ResourceType::CPU , ResourceStatus stat = ResourceStatus::IDLE,double Storage=50):
         Resource(id,name,t,rate,stat,Storage),coreCount(cores),frequency(frequency){}
-    void displayDetails() const override
+    void appendDetails(ReportBuffer& out) const override
     {
-        std::cout << "CPU Resource: " << resourceName << " (ID: " << resourceId << ")\n";
-        std::cout << "Type: " << (type == ResourceType::CPU ? "CPU" : "GPU") << "\n";
-        std::cout << "Status: " << (status == ResourceStatus::IDLE? "Available" : "In Use") << "\n";
-        std::cout << "Core Count: " << coreCount << "\n";
-        std::cout << "Frequency: " << frequency << " GHz\n";
-        std::cout << "Hourly Rate: $" << hourprice << "/hour\n";
-        std::cout << "Storage: " << Storage << " GB\n";
+        out << "CPU Resource: " << resourceName << " (ID: " << resourceId << ")\n";
+        out << "Type: " << (type == ResourceType::CPU ? "CPU" : "GPU") << "\n";
+        out << "Status: " << (status == ResourceStatus::IDLE? "Available" : "In Use") << "\n";
+        out << "Core Count: " << coreCount << "\n";
+        out << "Frequency: " << frequency << " GHz\n";
+        out << "Hourly Rate: $" << hourprice << "/hour\n";
+        out << "Storage: " << Storage << " GB\n";
 
     }
+    std::shared_ptr<Resource> clone() const override {
+        auto copy = std::make_shared<CPUResource>(*this);
+        copy->setListener(nullptr);
+        return copy;
+    }
     // CPU特定方法或参数访问器
     int getCoreCount() const{return coreCount;}
     double getFrequency() const{return frequency;}
+    bool getAttribute(ResourceAttribute attribute, double& value) const override {
+        switch (attribute) {
+            case ResourceAttribute::CORE_COUNT: value = coreCount; return true;
+            case ResourceAttribute::FREQUENCY: value = frequency; return true;
+            default: return Resource::getAttribute(attribute, value);
+        }
+    }
     void serialize(std::ostream& os) const override {
         // 先序列化基类部分
         Resource::serialize(os);
@@ -143,6 +253,18 @@ public:
         is.read(reinterpret_cast<char*>(&coreCount), sizeof(int));
         is.read(reinterpret_cast<char*>(&frequency), sizeof(double));
     }
+
+    void serialize(BinaryWriter& writer) const override {
+        Resource::serialize(writer);
+        writer.put(static_cast<int32_t>(coreCount));
+        writer.put(frequency);
+    }
+
+    void deserialize(BinaryReader& reader) override {
+        Resource::deserialize(reader);
+        coreCount = reader.get<int32_t>();
+        frequency = reader.get<double>();
+    }
 };
 
 /**
@@ -165,20 +287,32 @@ public:
 
     GPUResource(std::string id, std::string name, double rate ,int cudacores,int vram,ResourceType t=ResourceType::GPU , ResourceStatus stat = ResourceStatus::IDLE,double Storage=50):
     Resource(id,name,t,rate,stat,Storage),cudaCores(cudacores),vramG(vram){}
-    void displayDetails() const override
+    void appendDetails(ReportBuffer& out) const override
     {
-        std::cout << "GPU Resource: " << resourceName << " (ID: " << resourceId << ")\n";
-        std::cout << "Type: " << (type == ResourceType::CPU? "CPU" : "GPU") << "\n";
-        std::cout << "Status: " << (status == ResourceStatus::IDLE? "Available" : "In Use") << "\n";
-        std::cout << "Cuda Core Count: " << cudaCores << "\n";
-        std::cout << "VRAM: " << vramG << " GB\n";
-        std::cout << "Hourly Rate: $" << hourprice << "/hour\n";
-        std::cout << "Storage: " << Storage << " GB\n";
+        out << "GPU Resource: " << resourceName << " (ID: " << resourceId << ")\n";
+        out << "Type: " << (type == ResourceType::CPU? "CPU" : "GPU") << "\n";
+        out << "Status: " << (status == ResourceStatus::IDLE? "Available" : "In Use") << "\n";
+        out << "Cuda Core Count: " << cudaCores << "\n";
+        out << "VRAM: " << vramG << " GB\n";
+        out << "Hourly Rate: $" << hourprice << "/hour\n";
+        out << "Storage: " << Storage << " GB\n";
 
     }
+    std::shared_ptr<Resource> clone() const override {
+        auto copy = std::make_shared<GPUResource>(*this);
+        copy->setListener(nullptr);
+        return copy;
+    }
     // GPU特定方法and参数访问器
     int getCudaCores() const{return cudaCores;}
     int getVRAM() const{return vramG;} // 单位：G
+    bool getAttribute(ResourceAttribute attribute, double& value) const override {
+        switch (attribute) {
+            case ResourceAttribute::CUDA_CORES: value = cudaCores; return true;
+            case ResourceAttribute::VRAM: value = vramG; return true;
+            default: return Resource::getAttribute(attribute, value);
+        }
+    }
     void serialize(std::ostream& os) const override {
         // 先序列化基类部分
         Resource::serialize(os);
@@ -194,206 +328,878 @@ public:
         is.read(reinterpret_cast<char*>(&cudaCores), sizeof(int));
         is.read(reinterpret_cast<char*>(&vramG), sizeof(int));
     }
+
+    void serialize(BinaryWriter& writer) const override {
+        Resource::serialize(writer);
+        writer.put(static_cast<int32_t>(cudaCores));
+        writer.put(static_cast<int32_t>(vramG));
+    }
+
+    void deserialize(BinaryReader& reader) override {
+        Resource::deserialize(reader);
+        cudaCores = reader.get<int32_t>();
+        vramG = reader.get<int32_t>();
+    }
 };
 
+// 根据类型创建待反序列化的空资源对象
+inline std::shared_ptr<Resource> makeEmptyResource(ResourceType type) {
+    if (type == ResourceType::CPU) {
+        return std::make_shared<CPUResource>("", "", 0, 0, 0);
+    } else if (type == ResourceType::GPU) {
+        return std::make_shared<GPUResource>("", "", 0, 0, 0);
+    }
+    throw std::runtime_error("未知的资源类型");
+}
+
+// resources.dat 记录布局：类型u8 状态u8 存储f64 单价f64 ID 名称 [CPU: 核心i32 频率f64 | GPU: CUDA核心i32 显存i32]
+struct ResourceRecordTraits {
+    using Record = Resource;
+    static constexpr size_t kIdOffset = 1 + 1 + 8 + 8;
+    static constexpr size_t kKeyCount = 1; // 只按ID查找
+    // 一条记录的最小字节数：类型u8 状态u8 两个double 两个空字符串的长度前缀，再加GPU的两个int32
+    static constexpr uint64_t kMinRecordSize = 1 + 1 + 2 * sizeof(double) + 2 * sizeof(uint32_t) + 2 * sizeof(int32_t);
+
+    static const char* magic(); // ResourceCollection::kFileMagic，定义在集合之后
+
+    static void skip(BinaryReader& reader) {
+        auto type = static_cast<ResourceType>(reader.get<uint8_t>());
+        reader.skip(kIdOffset - 1);
+        reader.skip(reader.get<uint32_t>());
+        reader.skip(reader.get<uint32_t>());
+        reader.skip(type == ResourceType::CPU ? 4 + 8 : 4 + 4);
+    }
+
+    static std::string_view key(BinaryReader& reader, size_t) {
+        reader.skip(kIdOffset);
+        uint32_t length = reader.get<uint32_t>();
+        return std::string_view(reader.position(), length);
+    }
+
+    static std::shared_ptr<Resource> decode(BinaryReader& reader) {
+        auto resource = makeEmptyResource(static_cast<ResourceType>(reader.get<uint8_t>()));
+        resource->deserialize(reader);
+        return resource;
+    }
+};
+
+using LazyResourceFile = LazyRecordFile<ResourceRecordTraits>;
+
+
+/**
+ * @struct ResourceQuery
+ * @brief 多条件资源查询。
+ *
+ * 支持按类型、状态筛选，按属性做闭区间范围筛选，
+ * 并可按某一属性排序、只取前k个结果。
+ * 例：空闲、显存>=80G、单价<=9的GPU，按单价升序取前5个
+ *   ResourceQuery().ofType(ResourceType::GPU).onlyAvailable()
+ *       .atLeast(ResourceAttribute::VRAM, 80).atMost(ResourceAttribute::HOURLY_RATE, 9)
+ *       .orderBy(ResourceAttribute::HOURLY_RATE).top(5)
+ */
+struct ResourceQuery {
+    struct Range {
+        ResourceAttribute attribute;
+        double minValue;
+        double maxValue;
+    };
+
+    std::optional<ResourceType> type;
+    std::optional<ResourceStatus> status;
+    std::vector<Range> ranges;
+    std::optional<ResourceAttribute> sortAttribute;
+    bool ascending = true;
+    size_t limit = 0; // 0表示不限制数量
+
+    ResourceQuery& ofType(ResourceType t) { type = t; return *this; }
+    ResourceQuery& withStatus(ResourceStatus s) { status = s; return *this; }
+    ResourceQuery& onlyAvailable() { return withStatus(ResourceStatus::IDLE); }
+    ResourceQuery& inRange(ResourceAttribute attribute, double minValue, double maxValue) {
+        ranges.push_back({attribute, minValue, maxValue});
+        return *this;
+    }
+    ResourceQuery& atLeast(ResourceAttribute attribute, double minValue) {
+        return inRange(attribute, minValue, std::numeric_limits<double>::infinity());
+    }
+    ResourceQuery& atMost(ResourceAttribute attribute, double maxValue) {
+        return inRange(attribute, -std::numeric_limits<double>::infinity(), maxValue);
+    }
+    ResourceQuery& orderBy(ResourceAttribute attribute, bool asc = true) {
+        sortAttribute = attribute;
+        ascending = asc;
+        return *this;
+    }
+    ResourceQuery& top(size_t k) { limit = k; return *this; }
+};
 
 /**
  * @class ResourceCollection
  * @brief 管理系统中所有计算资源的集合。
  *
- * 提供添加、查找、列出资源的功能。
- * 可以按类型筛选资源。
+ * 提供添加、查找、删除、列出资源的功能。
+ * 资源存放在槽位表（ResourceSlotMap）中，删除只留下墓碑，O(1)且不移动其他资源，
+ * 新资源优先重用空槽位，因此遍历顺序为槽位顺序；调用方可以保存 ResourceHandle 代替字符串ID。
+ * 内部维护按ID的哈希索引，以及按类型、按状态的二级索引，
+ * 二级索引在添加、删除资源和资源状态变更时自动更新。
+ * 另有按属性值排序的属性索引供 query() 做范围查询，
+ * 该索引在资源增删或价格变化后标记为失效，下次查询时加锁重建，因此并发的 query() 是安全的
+ *（与其他只读操作一样，不能与修改操作并发）。
+ * 集合作为资源的状态监听者，因此不可复制，只能移动。
+ *
+ * openLazily() 以延迟模式加载：只映射文件并建立偏移索引，按ID查找时才解码该资源并加入集合；
+ * 第一次调用其他需要全部资源的操作（遍历、统计、查询、增删、保存等）时解码其余资源并退出延迟模式，
+ * 此后与普通加载相同，只是遍历顺序中先前按ID取得的资源排在前面。
+ * 延迟模式下的查找会填充集合，不能与其他操作并发。
  */
-class ResourceCollection {
+class ResourceCollection : public ResourceListener {
 private:
-    std::vector<std::shared_ptr<Resource>> resources;
+    // 二级索引桶：键为资源的槽位下标，保证遍历顺序与槽位顺序一致
+    using IndexBucket = std::map<uint32_t, std::shared_ptr<Resource>>;
 
-public:
-    // 添加资源到集合
-    void addResource(std::shared_ptr<Resource> resource) {
-        resources.push_back(resource);
+    struct IndexEntry {
+        std::shared_ptr<Resource> resource;
+        ResourceHandle handle;
+    };
+
+    ResourceSlotMap slots;
+    std::unordered_map<std::string, IndexEntry> idIndex;   // 资源ID -> 资源
+    std::map<ResourceType, IndexBucket> typeIndex;         // 资源类型 -> 资源
+    std::map<ResourceStatus, IndexBucket> statusIndex;     // 资源状态 -> 资源
+    std::map<ResourceType, IndexBucket> freeIndex;         // 资源类型 -> 该类型的空闲资源
+    std::vector<ResourceStatusObserver*> statusObservers;  // 绑定在集合对象上，移动时不转移
+
+    // 属性索引：每个属性一个按 (属性值, 槽位) 排序的数组
+    // 元素指向 idIndex 中的节点，unordered_map 的节点地址在重哈希后保持不变
+    using AttributeEntry = std::pair<double, const IndexEntry*>;
+    // 重建在 const 的 query() 中进行，并发查询时由互斥量保证只有一个线程重建，
+    // 其余线程等待重建完成；索引有效时查询不加锁
+    mutable std::array<std::vector<AttributeEntry>, kResourceAttributeCount> attributeIndex;
+    mutable std::atomic<bool> attributeIndexDirty{true};
+    mutable std::mutex attributeIndexMutex;
+
+    // 延迟模式的后备文件，为空表示全部资源都已在集合中
+    // 只有非 const 的 openLazily 能进入延迟模式，因此 const 查找中可以去掉 const 填充集合
+    std::unique_ptr<LazyResourceFile> lazy;
+
+    // 延迟模式下按ID解码一条资源并加入集合，未找到返回nullptr
+    std::shared_ptr<Resource> materialize(const std::string& id) const {
+        auto resource = lazy->findById(id);
+        if (resource && !idIndex.count(id)) {
+            const_cast<ResourceCollection*>(this)->insertResource(resource);
+        }
+        return resource;
     }
 
-    // 根据ID查找资源
-    std::shared_ptr<Resource> findResourceById(const std::string& id) const {
-        for (const auto& resource : resources) {
-            if (resource->getResourceId() == id) {
-                return resource;
+    // 解码尚未取得的全部资源并退出延迟模式
+    void materializeAll() const {
+        if (!lazy) {
+            return;
+        }
+        auto* self = const_cast<ResourceCollection*>(this);
+        self->slots.reserve(lazy->size());
+        self->idIndex.reserve(lazy->size());
+        for (size_t i = 0; i < lazy->size(); ++i) {
+            if (!lazy->isMaterialized(i)) {
+                self->insertResource(lazy->at(i));
             }
         }
-        return nullptr; // 未找到资源
+        self->lazy.reset();
     }
 
-    // 获取所有资源
-    const std::vector<std::shared_ptr<Resource>>& getAllResources() const {
-        return resources;
+    void ensureAttributeIndex() const {
+        if (!attributeIndexDirty.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(attributeIndexMutex);
+        if (attributeIndexDirty.load(std::memory_order_relaxed)) {
+            rebuildAttributeIndex();
+            attributeIndexDirty.store(false, std::memory_order_release);
+        }
     }
 
-    // 获取特定类型的资源
-    std::vector<std::shared_ptr<Resource>> getResourcesByType(ResourceType type) const {
-        std::vector<std::shared_ptr<Resource>> result;
-        for (const auto& resource : resources) {
-            if (resource->getResourceType() == type) {
-                result.push_back(resource);
+    void rebuildAttributeIndex() const {
+        for (auto& column : attributeIndex) {
+            column.clear();
+        }
+        for (const auto& item : idIndex) {
+            const IndexEntry& entry = item.second;
+            for (size_t a = 0; a < kResourceAttributeCount; ++a) {
+                double value;
+                if (entry.resource->getAttribute(static_cast<ResourceAttribute>(a), value)) {
+                    attributeIndex[a].emplace_back(value, &entry);
+                }
             }
         }
-        return result;
+        for (auto& column : attributeIndex) {
+            std::sort(column.begin(), column.end(), [](const AttributeEntry& x, const AttributeEntry& y) {
+                return x.first != y.first ? x.first < y.first : x.second->handle.index < y.second->handle.index;
+            });
+        }
     }
 
-    // 获取所有可用资源
-    std::vector<std::shared_ptr<Resource>> getAvailableResources() const {
+    static bool matches(const Resource& resource, const ResourceQuery& q) {
+        if (q.type && resource.getResourceType() != *q.type) return false;
+        if (q.status && resource.getStatus() != *q.status) return false;
+        for (const auto& range : q.ranges) {
+            double value;
+            if (!resource.getAttribute(range.attribute, value)) return false;
+            if (value < range.minValue || value > range.maxValue) return false;
+        }
+        return true;
+    }
+
+    template <typename Key>
+    static std::vector<std::shared_ptr<Resource>> collectBucket(const std::map<Key, IndexBucket>& index, Key key) {
         std::vector<std::shared_ptr<Resource>> result;
-        for (const auto& resource : resources) {
-            if (resource->isAvailable()) {
-                result.push_back(resource);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            result.reserve(it->second.size());
+            for (const auto& entry : it->second) {
+                result.push_back(entry.second);
             }
         }
         return result;
     }
 
-    // 获取特定类型的可用资源
-    std::vector<std::shared_ptr<Resource>> getAvailableResourcesByType(ResourceType type) const {
+    template <typename Key>
+    static size_t bucketSize(const std::map<Key, IndexBucket>& index, Key key) {
+        auto it = index.find(key);
+        return it == index.end() ? 0 : it->second.size();
+    }
+
+    template <typename Key, typename Visitor>
+    static void visitBucket(const std::map<Key, IndexBucket>& index, Key key, Visitor& visit) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return;
+        }
+        for (const auto& entry : it->second) {
+            visit(*entry.second);
+        }
+    }
+
+    template <typename Key, typename Visitor>
+    static void visitBucketShared(const std::map<Key, IndexBucket>& index, Key key, Visitor& visit) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return;
+        }
+        for (const auto& entry : it->second) {
+            visit(entry.second);
+        }
+    }
+
+    std::vector<std::string> collectFreeModels(ResourceType type) const {
+        materializeAll();
+        std::vector<std::string> models;
+        auto it = freeIndex.find(type);
+        if (it != freeIndex.end()) {
+            models.reserve(it->second.size());
+            for (const auto& entry : it->second) {
+                models.push_back(entry.second->getResourceName());
+            }
+        }
+        return models;
+    }
+
+    void detachAll() {
+        slots.forEach([](ResourceHandle, const std::shared_ptr<Resource>& resource) {
+            resource->setListener(nullptr);
+        });
+    }
+
+    void attachAll() {
+        slots.forEach([this](ResourceHandle, const std::shared_ptr<Resource>& resource) {
+            resource->setListener(this);
+        });
+    }
+
+    void indexInBuckets(const std::shared_ptr<Resource>& resource, uint32_t key) {
+        // 不重用槽位时新下标总是最大的，带尾部提示插入为均摊O(1)
+        auto insertInto = [&](IndexBucket& bucket) { bucket.emplace_hint(bucket.end(), key, resource); };
+        insertInto(typeIndex[resource->getResourceType()]);
+        insertInto(statusIndex[resource->getStatus()]);
+        if (resource->isAvailable()) {
+            insertInto(freeIndex[resource->getResourceType()]);
+        }
+    }
+
+public:
+    ResourceCollection() = default;
+    ResourceCollection(const ResourceCollection&) = delete;
+    ResourceCollection& operator=(const ResourceCollection&) = delete;
+
+    ResourceCollection(ResourceCollection&& other) noexcept
+        : slots(std::move(other.slots)),
+          idIndex(std::move(other.idIndex)),
+          typeIndex(std::move(other.typeIndex)),
+          statusIndex(std::move(other.statusIndex)),
+          freeIndex(std::move(other.freeIndex)),
+          lazy(std::move(other.lazy)) {
+        other.clear();
+        attachAll();
+    }
+
+    ResourceCollection& operator=(ResourceCollection&& other) noexcept {
+        if (this != &other) {
+            clear();
+            slots = std::move(other.slots);
+            idIndex = std::move(other.idIndex);
+            typeIndex = std::move(other.typeIndex);
+            statusIndex = std::move(other.statusIndex);
+            freeIndex = std::move(other.freeIndex);
+            lazy = std::move(other.lazy);
+            other.clear();
+            attachAll();
+        }
+        return *this;
+    }
+
+    ~ResourceCollection() override { detachAll(); }
+
+    // 添加资源到集合，ID重复时抛出异常
+    void addResource(std::shared_ptr<Resource> resource) {
+        materializeAll();
+        insertResource(std::move(resource));
+    }
+
+private:
+    void insertResource(std::shared_ptr<Resource> resource) {
+        const std::string id = resource->getResourceId();
+        if (idIndex.count(id)) {
+            throw std::runtime_error("资源ID已存在: " + id);
+        }
+        ResourceHandle handle = slots.insert(resource);
+        idIndex.emplace(id, IndexEntry{resource, handle});
+        indexInBuckets(resource, handle.index);
+        resource->setListener(this);
+        attributeIndexDirty = true;
+    }
+
+public:
+    // 从集合中删除资源，未找到时返回false
+    // 槽位留下墓碑，不移动其他资源，其他资源的句柄保持有效
+    bool removeResource(const std::string& id) {
+        materializeAll();
+        auto it = idIndex.find(id);
+        if (it == idIndex.end()) {
+            return false;
+        }
+        std::shared_ptr<Resource> resource = it->second.resource;
+        ResourceHandle handle = it->second.handle;
+        typeIndex[resource->getResourceType()].erase(handle.index);
+        statusIndex[resource->getStatus()].erase(handle.index);
+        freeIndex[resource->getResourceType()].erase(handle.index);
+        idIndex.erase(it);
+        slots.erase(handle);
+        resource->setListener(nullptr);
+        attributeIndexDirty = true;
+        return true;
+    }
+
+    bool removeResource(ResourceHandle handle) {
+        const auto& resource = slots.get(handle);
+        return resource ? removeResource(resource->getResourceId()) : false;
+    }
+
+    // 句柄接口：按ID取得句柄（未找到时为空句柄），按句柄解析资源（失效时为nullptr）
+    ResourceHandle getHandle(const std::string& id) const {
+        if (lazy) {
+            materialize(id);
+        }
+        auto it = idIndex.find(id);
+        return it == idIndex.end() ? ResourceHandle{} : it->second.handle;
+    }
+
+    std::shared_ptr<Resource> resolve(ResourceHandle handle) const {
+        return slots.get(handle);
+    }
+
+    size_t tombstoneCount() const { return slots.tombstoneCount(); }
+
+    // 紧凑槽位表，回收墓碑占用的空间
+    // 被移动资源的旧句柄会失效（解析为nullptr），调用方需通过回调或按ID重新取得句柄
+    template <typename Remap>
+    void compact(Remap remap) {
+        materializeAll();
+        std::unordered_map<uint32_t, ResourceHandle> moved;
+        slots.compact([&](ResourceHandle from, ResourceHandle to) {
+            moved.emplace(from.index, to);
+            remap(from, to);
+        });
+        typeIndex.clear();
+        statusIndex.clear();
+        freeIndex.clear();
+        for (auto& item : idIndex) {
+            auto it = moved.find(item.second.handle.index);
+            if (it != moved.end()) {
+                item.second.handle = it->second;
+            }
+        }
+        slots.forEach([this](ResourceHandle handle, const std::shared_ptr<Resource>& resource) {
+            indexInBuckets(resource, handle.index);
+        });
+        attributeIndexDirty = true;
+    }
+
+    void compact() {
+        compact([](ResourceHandle, ResourceHandle) {});
+    }
+
+    // 清空集合
+    void clear() {
+        detachAll();
+        slots.clear();
+        idIndex.clear();
+        typeIndex.clear();
+        statusIndex.clear();
+        freeIndex.clear();
+        lazy.reset();
+        attributeIndexDirty = true;
+    }
+
+    // 延迟模式加载 v2 格式文件，只建立偏移索引；verifyChecksum 为true时会读遍整个文件
+    void openLazily(const std::string& filename, bool verifyChecksum = false) {
+        auto file = std::make_unique<LazyResourceFile>();
+        file->open(filename, verifyChecksum);
+        clear();
+        lazy = std::move(file);
+    }
+
+    bool isLazy() const { return lazy != nullptr; }
+
+    // 资源状态变更回调：在状态索引和空闲集合中移动该资源
+    void onStatusChanged(Resource& resource, ResourceStatus oldStatus) override {
+        auto it = idIndex.find(resource.getResourceId());
+        if (it == idIndex.end()) {
+            return;
+        }
+        uint32_t key = it->second.handle.index;
+        statusIndex[oldStatus].erase(key);
+        statusIndex[resource.getStatus()].emplace(key, it->second.resource);
+        if (resource.isAvailable()) {
+            freeIndex[resource.getResourceType()].emplace(key, it->second.resource);
+        } else {
+            freeIndex[resource.getResourceType()].erase(key);
+        }
+        for (ResourceStatusObserver* observer : statusObservers) {
+            observer->onResourceStatusChanged(resource, oldStatus);
+        }
+    }
+
+    // 注册/注销资源状态观察者，观察者须在注销前保持有效
+    void addStatusObserver(ResourceStatusObserver* observer) {
+        if (std::find(statusObservers.begin(), statusObservers.end(), observer) == statusObservers.end()) {
+            statusObservers.push_back(observer);
+        }
+    }
+
+    void removeStatusObserver(ResourceStatusObserver* observer) {
+        statusObservers.erase(std::remove(statusObservers.begin(), statusObservers.end(), observer),
+                              statusObservers.end());
+    }
+
+    // 价格变更回调：属性索引失效
+    void onRateChanged(Resource&, double) override {
+        attributeIndexDirty = true;
+    }
+
+    // 多条件查询
+    // 选取命中区间最小的属性索引（或空闲集合/类型索引）作为驱动，只遍历该候选集，
+    // 其余条件逐个校验；排序属性与驱动属性相同时按索引顺序输出并可提前截断
+    std::vector<std::shared_ptr<Resource>> query(const ResourceQuery& q) const {
+        materializeAll();
+        ensureAttributeIndex();
+
+        // 在各范围条件中找候选最少的属性索引区间
+        const AttributeEntry* first = nullptr;
+        const AttributeEntry* last = nullptr;
+        std::optional<ResourceAttribute> driver;
+        for (const auto& range : q.ranges) {
+            const auto& column = attributeIndex[static_cast<size_t>(range.attribute)];
+            auto lo = std::lower_bound(column.begin(), column.end(), range.minValue,
+                [](const AttributeEntry& e, double v) { return e.first < v; });
+            auto hi = std::upper_bound(lo, column.end(), range.maxValue,
+                [](double v, const AttributeEntry& e) { return v < e.first; });
+            if (!driver || static_cast<size_t>(hi - lo) < static_cast<size_t>(last - first)) {
+                driver = range.attribute;
+                first = column.data() + (lo - column.begin());
+                last = column.data() + (hi - column.begin());
+            }
+        }
+
+        // 类型/状态条件对应的桶更小时改用桶驱动
+        const IndexBucket* bucket = nullptr;
+        if (q.type || q.status) {
+            const std::map<ResourceType, IndexBucket>* byType =
+                q.status == ResourceStatus::IDLE ? &freeIndex : &typeIndex;
+            if (q.type) {
+                auto it = byType->find(*q.type);
+                if (it == byType->end()) return {};
+                bucket = &it->second;
+            } else {
+                auto it = statusIndex.find(*q.status);
+                if (it == statusIndex.end()) return {};
+                bucket = &it->second;
+            }
+        }
+        bool useBucket = bucket && (!driver || bucket->size() < static_cast<size_t>(last - first));
+
         std::vector<std::shared_ptr<Resource>> result;
-        for (const auto& resource : resources) {
-            if (resource->getResourceType() == type && resource->isAvailable()) {
-                result.push_back(resource);
+        if (!useBucket && driver && q.sortAttribute == driver) {
+            // 按驱动索引顺序输出，满足limit后即停止
+            auto take = [&](const AttributeEntry& e) {
+                if (matches(*e.second->resource, q)) result.push_back(e.second->resource);
+                return q.limit != 0 && result.size() >= q.limit;
+            };
+            if (q.ascending) {
+                for (auto p = first; p != last; ++p) if (take(*p)) break;
+            } else {
+                // 倒序逐个属性值分组，组内仍按槽位升序，与其他路径的并列顺序一致
+                for (auto groupEnd = last; groupEnd != first;) {
+                    auto groupBegin = groupEnd - 1;
+                    while (groupBegin != first && (groupBegin - 1)->first == groupBegin->first) --groupBegin;
+                    bool done = false;
+                    for (auto p = groupBegin; p != groupEnd && !done; ++p) done = take(*p);
+                    if (done) break;
+                    groupEnd = groupBegin;
+                }
+            }
+            return result;
+        }
+
+        // 命中项：排序键 + 槽位，排序键相同时按槽位（目录顺序）排列，各执行路径结果一致
+        struct Hit {
+            double key;
+            uint32_t index;
+            const std::shared_ptr<Resource>* resource;
+        };
+        std::vector<Hit> hits;
+        auto collect = [&](uint32_t index, const std::shared_ptr<Resource>& resource) {
+            if (matches(*resource, q)) hits.push_back(Hit{0.0, index, &resource});
+        };
+        if (useBucket) {
+            for (const auto& entry : *bucket) {
+                collect(entry.first, entry.second);
+            }
+        } else if (driver) {
+            for (auto p = first; p != last; ++p) {
+                collect(p->second->handle.index, p->second->resource);
+            }
+        } else {
+            slots.forEach([&](ResourceHandle handle, const std::shared_ptr<Resource>& resource) {
+                collect(handle.index, resource);
+            });
+        }
+
+        if (q.sortAttribute) {
+            // 不具备排序属性的资源排在最后
+            for (Hit& hit : hits) {
+                if (!(*hit.resource)->getAttribute(*q.sortAttribute, hit.key)) {
+                    hit.key = q.ascending ? std::numeric_limits<double>::infinity()
+                                          : -std::numeric_limits<double>::infinity();
+                }
             }
         }
+        auto less = [&q](const Hit& x, const Hit& y) {
+            if (q.sortAttribute && x.key != y.key) {
+                return q.ascending ? x.key < y.key : x.key > y.key;
+            }
+            return x.index < y.index;
+        };
+        // 桶和槽位已按槽位有序，只有属性索引驱动或需要排序时才排序
+        if (q.sortAttribute || (!useBucket && driver)) {
+            if (q.limit != 0 && q.limit < hits.size()) {
+                std::partial_sort(hits.begin(), hits.begin() + q.limit, hits.end(), less);
+                hits.resize(q.limit);
+            } else {
+                std::sort(hits.begin(), hits.end(), less);
+            }
+        }
+        if (q.limit != 0 && hits.size() > q.limit) {
+            hits.resize(q.limit);
+        }
+        result.reserve(hits.size());
+        for (const Hit& hit : hits) {
+            result.push_back(*hit.resource);
+        }
         return result;
     }
 
-    // 显示所有资源
-    void displayAllResources() const {
-        std::cout << "===== 所有资源列表 =====\n";
-        for (const auto& resource : resources) {
-            resource->displayDetails();
-            std::cout << "------------------------\n";
+    // 根据ID查找资源
+    std::shared_ptr<Resource> findResourceById(const std::string& id) const {
+        auto it = idIndex.find(id);
+        if (it == idIndex.end()) {
+            return lazy ? materialize(id) : nullptr; // 未找到资源
         }
+        return it->second.resource;
+    }
+
+    // 资源总数
+    size_t size() const { return lazy ? lazy->size() : slots.size(); }
+
+    // 获取所有资源（按槽位顺序）
+    std::vector<std::shared_ptr<Resource>> getAllResources() const {
+        materializeAll();
+        std::vector<std::shared_ptr<Resource>> result;
+        result.reserve(slots.size());
+        slots.forEach([&result](ResourceHandle, const std::shared_ptr<Resource>& resource) {
+            result.push_back(resource);
+        });
+        return result;
+    }
+
+    // 获取特定类型的资源
+    std::vector<std::shared_ptr<Resource>> getResourcesByType(ResourceType type) const {
+        materializeAll();
+        return collectBucket(typeIndex, type);
+    }
+
+    // 获取特定状态的资源
+    std::vector<std::shared_ptr<Resource>> getResourcesByStatus(ResourceStatus status) const {
+        materializeAll();
+        return collectBucket(statusIndex, status);
+    }
+
+    // 遍历接口：回调参数为 Resource&，不分配内存、不复制 shared_ptr
+    // 回调中不得增删资源，也不得改变正在遍历的状态桶/空闲集合中资源的状态
+    template <typename Visitor>
+    void forEachResource(Visitor visit) const {
+        materializeAll();
+        slots.forEach([&visit](ResourceHandle, const std::shared_ptr<Resource>& resource) {
+            visit(*resource);
+        });
+    }
+
+    // 按槽位顺序遍历第 offset 个起的至多 limit 个资源，用于分页
+    template <typename Visitor>
+    void forEachResourceInRange(size_t offset, size_t limit, Visitor visit) const {
+        materializeAll();
+        slots.forEachInRange(offset, limit, [&visit](ResourceHandle, const std::shared_ptr<Resource>& resource) {
+            visit(*resource);
+        });
+    }
+
+    template <typename Visitor>
+    void forEachByType(ResourceType type, Visitor visit) const {
+        materializeAll();
+        visitBucket(typeIndex, type, visit);
+    }
+
+    template <typename Visitor>
+    void forEachByStatus(ResourceStatus status, Visitor visit) const {
+        materializeAll();
+        visitBucket(statusIndex, status, visit);
+    }
+
+    template <typename Visitor>
+    void forEachAvailable(Visitor visit) const {
+        materializeAll();
+        visitBucket(statusIndex, ResourceStatus::IDLE, visit);
+    }
+
+    template <typename Visitor>
+    void forEachAvailableByType(ResourceType type, Visitor visit) const {
+        materializeAll();
+        visitBucket(freeIndex, type, visit);
+    }
+
+    // 同上，但回调参数为 const std::shared_ptr<Resource>&，供需要持有资源的调用方使用，
+    // 只在回调选中资源时才复制 shared_ptr
+    template <typename Visitor>
+    void forEachSharedByType(ResourceType type, Visitor visit) const {
+        materializeAll();
+        visitBucketShared(typeIndex, type, visit);
+    }
+
+    template <typename Visitor>
+    void forEachSharedAvailable(Visitor visit) const {
+        materializeAll();
+        visitBucketShared(statusIndex, ResourceStatus::IDLE, visit);
+    }
+
+    // 统计特定类型/状态的资源数量
+    size_t countByType(ResourceType type) const {
+        materializeAll();
+        return bucketSize(typeIndex, type);
+    }
+    size_t countByStatus(ResourceStatus status) const {
+        materializeAll();
+        return bucketSize(statusIndex, status);
+    }
+
+    // 统计可用资源数量，O(1)
+    size_t countAvailable() const { return countByStatus(ResourceStatus::IDLE); }
+    size_t countAvailableByType(ResourceType type) const {
+        materializeAll();
+        return bucketSize(freeIndex, type);
+    }
+
+    // 获取所有可用资源
+    std::vector<std::shared_ptr<Resource>> getAvailableResources() const {
+        materializeAll();
+        return collectBucket(statusIndex, ResourceStatus::IDLE);
+    }
+
+    // 获取特定类型的可用资源
+    std::vector<std::shared_ptr<Resource>> getAvailableResourcesByType(ResourceType type) const {
+        materializeAll();
+        return collectBucket(freeIndex, type);
+    }
+
+    // 显示所有资源（整体格式化后一次输出）
+    void displayAllResources() const {
+        ReportBuffer out(size() * 200 + 64);
+        out << "===== 所有资源列表 =====\n";
+        forEachResource([&out](const Resource& resource) {
+            resource.appendDetails(out);
+            out << "------------------------\n";
+        });
+        out.writeTo(std::cout);
     }
 
     // 显示特定类型的资源
     void displayResourcesByType(ResourceType type) const {
-        std::cout << "===== " << (type == ResourceType::CPU ? "CPU" : "GPU") << " 资源列表 =====\n";
-        for (const auto& resource : resources) {
-            if (resource->getResourceType() == type) {
-                resource->displayDetails();
-                std::cout << "------------------------\n";
-            }
-        }
+        ReportBuffer out(countByType(type) * 200 + 64);
+        out << "===== " << (type == ResourceType::CPU ? "CPU" : "GPU") << " 资源列表 =====\n";
+        forEachByType(type, [&out](const Resource& resource) {
+            resource.appendDetails(out);
+            out << "------------------------\n";
+        });
+        out.writeTo(std::cout);
     }
     
     // 返回可用CPU资源型号列表
     std::vector<std::string> getAvailableCPUModels() const {
-        std::vector<std::string> models;
-        for (const auto& resource : resources) {
-            if (resource->getResourceType() == ResourceType::CPU && resource->isAvailable()) {
-                models.push_back(resource->getResourceName());
-            }
-        }
-        return models;
+        return collectFreeModels(ResourceType::CPU);
     }
     
     // 返回可用GPU资源型号列表
     std::vector<std::string> getAvailableGPUModels() const {
-        std::vector<std::string> models;
-        for (const auto& resource : resources) {
-            if (resource->getResourceType() == ResourceType::GPU && resource->isAvailable()) {
-                models.push_back(resource->getResourceName());
-            }
-        }
-        return models;
+        return collectFreeModels(ResourceType::GPU);
     }
     
     // 打印可用CPU资源型号
     void displayAvailableCPUModels() const {
-        std::cout << "===== 可用CPU型号列表 =====\n";
-        auto models = getAvailableCPUModels();
-        if (models.empty()) {
-            std::cout << "当前没有可用的CPU资源\n";
-        } else {
-            for (const auto& model : models) {
-                std::cout << "- " << model << "\n";
-            }
+        ReportBuffer out;
+        out << "===== 可用CPU型号列表 =====\n";
+        if (countAvailableByType(ResourceType::CPU) == 0) {
+            out << "当前没有可用的CPU资源\n";
         }
+        forEachAvailableByType(ResourceType::CPU, [&out](const Resource& resource) {
+            out << "- " << resource.getResourceName() << "\n";
+        });
+        out.writeTo(std::cout);
     }
     
     // 打印可用GPU资源型号
     void displayAvailableGPUModels() const {
-        std::cout << "===== 可用GPU型号列表 =====\n";
-        auto models = getAvailableGPUModels();
-        if (models.empty()) {
-            std::cout << "当前没有可用的GPU资源\n";
-        } else {
-            for (const auto& model : models) {
-                std::cout << "- " << model << "\n";
-            }
+        ReportBuffer out;
+        out << "===== 可用GPU型号列表 =====\n";
+        if (countAvailableByType(ResourceType::GPU) == 0) {
+            out << "当前没有可用的GPU资源\n";
         }
+        forEachAvailableByType(ResourceType::GPU, [&out](const Resource& resource) {
+            out << "- " << resource.getResourceName() << "\n";
+        });
+        out.writeTo(std::cout);
     }
 
     // 持久化方法
+    // 以 v2 格式保存：所有记录先写入一块缓冲区，再整体写入文件
+    static constexpr char kFileMagic[4] = {'C', 'R', 'E', 'S'};
+    static constexpr uint64_t kMinRecordSize = ResourceRecordTraits::kMinRecordSize;
+
     void saveToFile(const std::string& filename) {
-        std::ofstream file(filename, std::ios::binary);
-        if (!file) {
-            throw std::runtime_error("无法打开文件进行写入: " + filename);
-        }
-        
-        // 写入资源数量
-        size_t count = resources.size();
-        file.write(reinterpret_cast<const char*>(&count), sizeof(size_t));
-        
-        // 逐个写入资源
-        for (const auto& resource : resources) {
+        BinaryWriter writer = snapshot();
+        writer.writeToFile(filename, kFileMagic, slots.size());
+    }
+
+    // 将全部资源序列化到内存缓冲区（尚未回填文件头）
+    BinaryWriter snapshot() const {
+        materializeAll();
+        BinaryWriter writer(kBinaryHeaderSize + slots.size() * 64);
+        forEachResource([&writer](const Resource& resource) {
             // 写入资源类型标识
-            ResourceType type = resource->getResourceType();
-            file.write(reinterpret_cast<const char*>(&type), sizeof(ResourceType));
-            
-            // 根据类型序列化资源
-            resource->serialize(file);
-        }
-        
-        file.close();
+            writer.put(static_cast<uint8_t>(resource.getResourceType()));
+            resource.serialize(writer);
+        });
+        return writer;
     }
 
+    // 加载 v2 格式文件，文件不是 v2 格式时按旧格式读取
     void loadFromFile(const std::string& filename) {
-        std::ifstream file(filename, std::ios::binary);
-        if (!file) {
-            throw std::runtime_error("无法打开文件进行读取: " + filename);
+        std::vector<char> data;
+        BinaryFileHeader header;
+        if (!readBinaryFile(filename, kFileMagic, data, header)) {
+            std::ifstream file(filename, std::ios::binary);
+            loadLegacy(file);
+            return;
         }
-        
-        // 清空当前资源
-        resources.clear();
+
+        // 记录数不在校验和覆盖范围内，先用记录区长度约束它再预留空间
+        uint64_t recordBytes = header.payloadSize;
+        std::vector<BinaryBlock> blocks;
+        if (readBlockIndex(data.data(), header, blocks)) {
+            recordBytes = blocks.empty() ? 0 : blocks.back().offset + blocks.back().size;
+        }
+        if (header.recordCount > recordBytes / kMinRecordSize) {
+            throw std::runtime_error("数据文件已损坏：记录数不符");
+        }
+
+        // 清空当前资源及索引
+        clear();
+        slots.reserve(header.recordCount);
+        idIndex.reserve(header.recordCount);
+
+        // 任何一条记录解码或加入失败都清空集合，不留下加载了一半的状态
+        try {
+            BinaryReader reader(data.data() + kBinaryHeaderSize, recordBytes);
+            for (uint64_t i = 0; i < header.recordCount; ++i) {
+                auto resource = makeEmptyResource(static_cast<ResourceType>(reader.get<uint8_t>()));
+                resource->deserialize(reader);
+                addResource(resource);
+            }
+            // 记录数偏小时记录区会有剩余，不能静默丢弃后面的资源
+            if (reader.remaining() != 0) {
+                throw std::runtime_error("数据文件已损坏：记录数不符");
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    // 读取旧格式（size_t 数量 + 逐字段写入、'\0' 结尾字符串）
+    void loadLegacy(std::istream& file) {
+        // 清空当前资源及索引
+        clear();
         
         // 读取资源数量
         size_t count;
         file.read(reinterpret_cast<char*>(&count), sizeof(size_t));
         
         // 逐个读取资源
-        for (size_t i = 0; i < count; ++i) {
+        for (size_t i = 0; i < count && file; ++i) {
             // 读取资源类型标识
             ResourceType type;
             file.read(reinterpret_cast<char*>(&type), sizeof(ResourceType));
             
-            // 根据类型创建相应的资源对象
-            std::shared_ptr<Resource> resource;
-            if (type == ResourceType::CPU) {
-                resource = std::make_shared<CPUResource>("", "", 0, 0, 0);
-            } else if (type == ResourceType::GPU) {
-                resource = std::make_shared<GPUResource>("", "", 0, 0, 0);
-            } else {
-                throw std::runtime_error("未知的资源类型");
-            }
-            
-            // 反序列化资源
+            // 根据类型创建相应的资源对象并反序列化
+            auto resource = makeEmptyResource(type);
             resource->deserialize(file);
             
-            // 添加到集合
-            resources.push_back(resource);
+            // 添加到集合（同时建立索引）
+            addResource(resource);
+        }
+        if (!file) {
+            throw std::runtime_error("旧格式资源文件已损坏");
         }
-        
-        file.close();
     }
 };
 
+inline const char* ResourceRecordTraits::magic() { return ResourceCollection::kFileMagic; }
+
 // 创建预设资源集合的辅助函数
 inline ResourceCollection createDefaultResourceCollection() {
     ResourceCollection collection;
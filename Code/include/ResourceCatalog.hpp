@@ -0,0 +1,282 @@
+// ResourceCatalog.hpp
+#ifndef RESOURCE_CATALOG_HPP
+#define RESOURCE_CATALOG_HPP
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+#include <stdexcept>
+#include "Resource.hpp"
+#include "ReportBuffer.hpp"
+
+class ResourceCatalog;
+
+/**
+ * @class ResourceView
+ * @brief 列式目录中一行资源的轻量视图。
+ *
+ * 只保存目录指针和行号，按需从各列读取字段，
+ * 只读接口与 Resource 的获取器一致。目录是快照，视图不提供设置器，
+ * 修改资源须通过 ResourceCollection。视图在目录存续期间有效。
+ */
+class ResourceView {
+private:
+    const ResourceCatalog* catalog;
+    size_t row;
+
+public:
+    ResourceView(const ResourceCatalog* c, size_t r) : catalog(c), row(r) {}
+
+    size_t getRow() const { return row; }
+
+    // 获取器
+    const std::string& getResourceId() const;
+    const std::string& getResourceName() const;
+    ResourceType getResourceType() const;
+    ResourceStatus getStatus() const;
+    double getHourlyRate() const;
+    double getStorage() const;
+    int getCoreCount() const;   // 非CPU资源为0
+    double getFrequency() const; // 非CPU资源为0
+    int getCudaCores() const;   // 非GPU资源为0
+    int getVRAM() const;        // 非GPU资源为0
+    bool isAvailable() const { return getStatus() == ResourceStatus::IDLE; }
+
+    // 直接从各列格式化资源详情，格式与 Resource::appendDetails 相同
+    void appendDetails(ReportBuffer& out) const;
+    void displayDetails() const;
+
+    // 还原为独立的多态资源对象
+    std::shared_ptr<Resource> toResource() const;
+};
+
+/**
+ * @class ResourceCatalog
+ * @brief 按列存储的资源目录（结构数组）。
+ *
+ * ID、名称、类型、状态、价格、存储以及CPU/GPU特有字段各自存放在连续数组中，
+ * 所有行都包含全部列，不适用的字段填0，使筛选与聚合成为无分支的顺序循环，
+ * 便于编译器向量化。单个资源通过 ResourceView 访问。
+ * 目录是 fromCollection() 时刻的只读快照，不监听资源变更，
+ * 集合中的资源改变后须重新构建；目录只用于批量筛选与聚合。
+ * 行只在构建时追加，对外只有 fromCollection() 一个入口。
+ */
+class ResourceCatalog {
+private:
+    friend class ResourceView;
+
+    std::vector<std::string> ids;
+    std::vector<std::string> names;
+    std::vector<uint8_t> types;     // ResourceType
+    std::vector<uint8_t> statuses;  // ResourceStatus
+    std::vector<double> hourprices;
+    std::vector<double> storages;
+    std::vector<int32_t> coreCounts;
+    std::vector<double> frequencies;
+    std::vector<int32_t> cudaCores;
+    std::vector<int32_t> vrams;
+    std::unordered_map<std::string, size_t> rowById;
+
+    static uint8_t code(ResourceType t) { return static_cast<uint8_t>(t); }
+    static uint8_t code(ResourceStatus s) { return static_cast<uint8_t>(s); }
+
+    size_t appendRow(const std::string& id, const std::string& name, ResourceType type,
+                     ResourceStatus status, double rate, double storage) {
+        if (rowById.count(id)) {
+            throw std::runtime_error("资源ID已存在: " + id);
+        }
+        size_t row = ids.size();
+        ids.push_back(id);
+        names.push_back(name);
+        types.push_back(code(type));
+        statuses.push_back(code(status));
+        hourprices.push_back(rate);
+        storages.push_back(storage);
+        coreCounts.push_back(0);
+        frequencies.push_back(0.0);
+        cudaCores.push_back(0);
+        vrams.push_back(0);
+        rowById.emplace(id, row);
+        return row;
+    }
+
+    // 以下修改行的方法只供 fromCollection() 构建快照使用
+    void reserve(size_t n) {
+        ids.reserve(n);
+        names.reserve(n);
+        types.reserve(n);
+        statuses.reserve(n);
+        hourprices.reserve(n);
+        storages.reserve(n);
+        coreCounts.reserve(n);
+        frequencies.reserve(n);
+        cudaCores.reserve(n);
+        vrams.reserve(n);
+        rowById.reserve(n);
+    }
+
+    ResourceView addCPU(const std::string& id, const std::string& name, double rate, int cores,
+                        double frequency, ResourceStatus status = ResourceStatus::IDLE, double storage = 50) {
+        size_t row = appendRow(id, name, ResourceType::CPU, status, rate, storage);
+        coreCounts[row] = cores;
+        frequencies[row] = frequency;
+        return ResourceView(this, row);
+    }
+
+    ResourceView addGPU(const std::string& id, const std::string& name, double rate, int cudacores,
+                        int vram, ResourceStatus status = ResourceStatus::IDLE, double storage = 50) {
+        size_t row = appendRow(id, name, ResourceType::GPU, status, rate, storage);
+        cudaCores[row] = cudacores;
+        vrams[row] = vram;
+        return ResourceView(this, row);
+    }
+
+    // 从多态资源对象复制一行
+    ResourceView addResource(const Resource& resource) {
+        double v1 = 0, v2 = 0;
+        if (resource.getResourceType() == ResourceType::CPU) {
+            resource.getAttribute(ResourceAttribute::CORE_COUNT, v1);
+            resource.getAttribute(ResourceAttribute::FREQUENCY, v2);
+            return addCPU(resource.getResourceId(), resource.getResourceName(), resource.getHourlyRate(),
+                          static_cast<int>(v1), v2, resource.getStatus(), resource.getStorage());
+        }
+        resource.getAttribute(ResourceAttribute::CUDA_CORES, v1);
+        resource.getAttribute(ResourceAttribute::VRAM, v2);
+        return addGPU(resource.getResourceId(), resource.getResourceName(), resource.getHourlyRate(),
+                      static_cast<int>(v1), static_cast<int>(v2), resource.getStatus(), resource.getStorage());
+    }
+
+public:
+    size_t size() const { return ids.size(); }
+
+    // 由资源集合构建列式目录，这是构建目录的唯一入口
+    static ResourceCatalog fromCollection(const ResourceCollection& collection) {
+        ResourceCatalog catalog;
+        catalog.reserve(collection.size());
+        collection.forEachResource([&catalog](const Resource& resource) {
+            catalog.addResource(resource);
+        });
+        return catalog;
+    }
+
+    // 根据ID查找资源，未找到返回false
+    bool findResourceById(const std::string& id, size_t& row) const {
+        auto it = rowById.find(id);
+        if (it == rowById.end()) {
+            return false;
+        }
+        row = it->second;
+        return true;
+    }
+
+    ResourceView at(size_t row) const { return ResourceView(this, row); }
+
+    // 聚合查询：以下均为对连续列的顺序循环，条件以乘法/计数代替分支
+
+    // 空闲GPU显存总量（非GPU行显存为0，无需判断类型）
+    long long totalIdleVRAM() const {
+        const uint8_t idle = code(ResourceStatus::IDLE);
+        long long total = 0;
+        for (size_t i = 0, n = vrams.size(); i < n; ++i) {
+            total += static_cast<long long>(statuses[i] == idle) * vrams[i];
+        }
+        return total;
+    }
+
+    // 特定类型资源的平均每小时价格，无该类型资源时返回0
+    double averageHourlyRate(ResourceType type) const {
+        const uint8_t t = code(type);
+        double sum = 0;
+        size_t count = 0;
+        for (size_t i = 0, n = hourprices.size(); i < n; ++i) {
+            bool hit = types[i] == t;
+            sum += hit ? hourprices[i] : 0.0;
+            count += hit;
+        }
+        return count == 0 ? 0.0 : sum / count;
+    }
+
+    size_t countByStatus(ResourceStatus status) const {
+        const uint8_t s = code(status);
+        size_t count = 0;
+        for (size_t i = 0, n = statuses.size(); i < n; ++i) {
+            count += statuses[i] == s;
+        }
+        return count;
+    }
+
+    size_t countAvailableByType(ResourceType type) const {
+        const uint8_t t = code(type);
+        const uint8_t idle = code(ResourceStatus::IDLE);
+        size_t count = 0;
+        for (size_t i = 0, n = types.size(); i < n; ++i) {
+            count += (types[i] == t) & (statuses[i] == idle);
+        }
+        return count;
+    }
+
+    // 空闲CPU核心总数
+    long long totalIdleCores() const {
+        const uint8_t idle = code(ResourceStatus::IDLE);
+        long long total = 0;
+        for (size_t i = 0, n = coreCounts.size(); i < n; ++i) {
+            total += static_cast<long long>(statuses[i] == idle) * coreCounts[i];
+        }
+        return total;
+    }
+
+    // 逐行遍历，回调参数为 ResourceView
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (size_t i = 0, n = ids.size(); i < n; ++i) {
+            visit(ResourceView(this, i));
+        }
+    }
+};
+
+inline const std::string& ResourceView::getResourceId() const { return catalog->ids[row]; }
+inline const std::string& ResourceView::getResourceName() const { return catalog->names[row]; }
+inline ResourceType ResourceView::getResourceType() const { return static_cast<ResourceType>(catalog->types[row]); }
+inline ResourceStatus ResourceView::getStatus() const { return static_cast<ResourceStatus>(catalog->statuses[row]); }
+inline double ResourceView::getHourlyRate() const { return catalog->hourprices[row]; }
+inline double ResourceView::getStorage() const { return catalog->storages[row]; }
+inline int ResourceView::getCoreCount() const { return catalog->coreCounts[row]; }
+inline double ResourceView::getFrequency() const { return catalog->frequencies[row]; }
+inline int ResourceView::getCudaCores() const { return catalog->cudaCores[row]; }
+inline int ResourceView::getVRAM() const { return catalog->vrams[row]; }
+
+inline std::shared_ptr<Resource> ResourceView::toResource() const {
+    if (getResourceType() == ResourceType::CPU) {
+        return std::make_shared<CPUResource>(getResourceId(), getResourceName(), getHourlyRate(), getCoreCount(),
+                                             getFrequency(), ResourceType::CPU, getStatus(), getStorage());
+    }
+    return std::make_shared<GPUResource>(getResourceId(), getResourceName(), getHourlyRate(), getCudaCores(),
+                                         getVRAM(), ResourceType::GPU, getStatus(), getStorage());
+}
+
+inline void ResourceView::appendDetails(ReportBuffer& out) const {
+    bool cpu = getResourceType() == ResourceType::CPU;
+    out << (cpu ? "CPU Resource: " : "GPU Resource: ") << getResourceName() << " (ID: " << getResourceId() << ")\n";
+    out << "Type: " << (cpu ? "CPU" : "GPU") << "\n";
+    out << "Status: " << (isAvailable() ? "Available" : "In Use") << "\n";
+    if (cpu) {
+        out << "Core Count: " << getCoreCount() << "\n";
+        out << "Frequency: " << getFrequency() << " GHz\n";
+    } else {
+        out << "Cuda Core Count: " << getCudaCores() << "\n";
+        out << "VRAM: " << getVRAM() << " GB\n";
+    }
+    out << "Hourly Rate: $" << getHourlyRate() << "/hour\n";
+    out << "Storage: " << getStorage() << " GB\n";
+}
+
+inline void ResourceView::displayDetails() const {
+    ReportBuffer out(512);
+    appendDetails(out);
+    out.writeTo(std::cout);
+}
+
+#endif // RESOURCE_CATALOG_HPP
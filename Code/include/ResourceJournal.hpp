@@ -0,0 +1,370 @@
+// ResourceJournal.hpp
+#ifndef RESOURCE_JOURNAL_HPP
+#define RESOURCE_JOURNAL_HPP
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <cstdio>
+#include <filesystem>
+#include <algorithm>
+#include <stdexcept>
+#include <exception>
+#include "BinaryFormat.hpp"
+#include "Resource.hpp"
+
+// 日志记录类型
+enum class JournalOp : uint8_t {
+    ADD = 1,       // 完整资源记录（已存在则覆盖）
+    MODIFY = 2,    // ID、新名称、新单价
+    REMOVE = 3,    // ID
+    STATUS = 4,    // ID、新状态
+    TYPE_RATE = 5, // 资源类型、新单价（批量调价只记一条）
+};
+
+/**
+ * @class ResourceJournal
+ * @brief 资源目录的追加式变更日志。
+ *
+ * 每次管理操作只向日志文件追加一条记录，代价为 O(记录) 而非重写整个 resources.dat。
+ * 加载时先读快照（resources.dat），再按顺序重放日志。
+ * 日志超过快照大小（且不小于下限）时触发压缩：在前台把当前状态序列化到内存并把日志改名为旧日志(.old)，
+ * 写快照文件由后台线程完成（临时文件刷盘后改名），写完后删除旧日志。
+ * 旧日志存在时（上次后台压缩失败或进程在压缩中退出）它是其中修改的唯一副本，绝不覆盖：
+ * 下一次压缩改为在前台同步写快照，成功后才删除旧日志并清空当前日志，失败则抛出异常。
+ * 追加记录触发的压缩失败时记录已经写入，不抛出：错误与后台压缩的失败一样保存下来，
+ * 由 waitForCompaction() 重新抛出，下一次追加时再次尝试压缩。
+ * 所有记录都是“设置”语义，重放是幂等的，因此压缩过程中崩溃留下的旧日志可以安全地再次重放。
+ * 资源状态变更（审批分配、整组调度等）不经管理员操作，日志作为集合的状态观察者自动记录，
+ * 重放期间产生的状态回调不再记录。
+ *
+ * 日志文件格式：魔数"CJNL" 版本u32，之后每条记录为 长度u32 校验u32 正文（op u8 + 字段），
+ * 末尾不完整或校验失败的记录视为写入中断，重放时截断；不足8字节的文件视为文件头写入中断，整个截断。
+ */
+class ResourceJournal : public ResourceStatusObserver {
+private:
+    static constexpr char kMagic[4] = {'C', 'J', 'N', 'L'};
+    static constexpr size_t kFileHeaderSize = 8;
+    static constexpr size_t kEntryHeaderSize = 8;
+    static constexpr uint64_t kMinCompactionBytes = 1 << 20;
+
+    ResourceCollection& collection;
+    std::string snapshotFile;
+    std::string journalFile;
+    std::ofstream journal;
+    uint64_t journalBytes = 0;
+    uint64_t snapshotBytes = 0;
+    std::thread compactor;
+    bool replaying = false; // load() 期间不记录集合的状态回调
+    std::exception_ptr compactionError; // 压缩的失败（后台的在 join 后才读取），由 waitForCompaction() 抛出
+
+    std::string oldJournalFile() const { return journalFile + ".old"; }
+
+    // 把快照写入临时文件，刷盘后替换快照文件
+    static void writeSnapshot(BinaryWriter& snapshot, const std::string& target, uint64_t count) {
+        std::string tmp = target + ".tmp";
+        snapshot.writeToFile(tmp, ResourceCollection::kFileMagic, count);
+        replaceFileDurably(tmp, target);
+    }
+
+    void joinCompactor() {
+        if (compactor.joinable()) {
+            compactor.join();
+        }
+    }
+
+    static uint32_t entryChecksum(const char* data, size_t size) {
+        return static_cast<uint32_t>(payloadChecksum(data, size));
+    }
+
+    void openJournal() {
+        bool fresh = !std::filesystem::exists(journalFile) || std::filesystem::file_size(journalFile) == 0;
+        journal.open(journalFile, std::ios::binary | std::ios::app);
+        if (!journal) {
+            throw std::runtime_error("无法打开日志文件: " + journalFile);
+        }
+        if (fresh) {
+            // 魔数和版本一次写出，崩溃时至多留下不足8字节的文件头，由 replay() 截断
+            char header[kFileHeaderSize];
+            uint32_t version = kBinaryFormatVersion;
+            std::memcpy(header, kMagic, 4);
+            std::memcpy(header + 4, &version, sizeof(version));
+            journal.write(header, kFileHeaderSize);
+            journal.flush();
+        }
+        journalBytes = std::filesystem::file_size(journalFile);
+    }
+
+    // 追加一条记录：长度、校验和正文一次写出；只有记录本身未写入时抛出异常
+    void append(const std::string& body) {
+        if (!journal.is_open()) {
+            openJournal();
+        }
+        std::string entry;
+        entry.reserve(kEntryHeaderSize + body.size());
+        uint32_t length = static_cast<uint32_t>(body.size());
+        uint32_t checksum = entryChecksum(body.data(), body.size());
+        entry.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        entry.append(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        entry.append(body);
+        journal.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+        journal.flush();
+        if (!journal) {
+            throw std::runtime_error("写入日志失败: " + journalFile);
+        }
+        journalBytes += entry.size();
+        if (journalBytes >= std::max(kMinCompactionBytes, snapshotBytes)) {
+            try {
+                compact();
+            } catch (...) {
+                compactionError = std::current_exception();
+            }
+        }
+    }
+
+    void apply(BinaryReader& reader) {
+        auto op = static_cast<JournalOp>(reader.get<uint8_t>());
+        switch (op) {
+            case JournalOp::ADD: {
+                auto resource = makeEmptyResource(static_cast<ResourceType>(reader.get<uint8_t>()));
+                resource->deserialize(reader);
+                collection.removeResource(resource->getResourceId());
+                collection.addResource(resource);
+                break;
+            }
+            case JournalOp::MODIFY: {
+                std::string id = reader.getString();
+                std::string name = reader.getString();
+                double rate = reader.get<double>();
+                if (auto resource = collection.findResourceById(id)) {
+                    resource->setResourceName(name);
+                    resource->setHourlyRate(rate);
+                }
+                break;
+            }
+            case JournalOp::REMOVE:
+                collection.removeResource(reader.getString());
+                break;
+            case JournalOp::STATUS: {
+                std::string id = reader.getString();
+                auto status = static_cast<ResourceStatus>(reader.get<uint8_t>());
+                if (auto resource = collection.findResourceById(id)) {
+                    resource->setStatus(status);
+                }
+                break;
+            }
+            case JournalOp::TYPE_RATE: {
+                auto type = static_cast<ResourceType>(reader.get<uint8_t>());
+                double rate = reader.get<double>();
+                collection.forEachByType(type, [rate](Resource& resource) {
+                    resource.setHourlyRate(rate);
+                });
+                break;
+            }
+            default:
+                throw std::runtime_error("未知的日志记录类型");
+        }
+    }
+
+    // 重放一个日志文件，返回完整记录的结束位置；尾部残缺记录由调用方截断
+    uint64_t replay(const std::string& filename) {
+        std::vector<char> data;
+        {
+            std::ifstream file(filename, std::ios::binary | std::ios::ate);
+            if (!file) {
+                // 调用方已确认文件存在，打不开时不能当作空文件截断
+                throw std::runtime_error("无法打开日志文件: " + filename);
+            }
+            data.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+        if (data.size() < kFileHeaderSize) {
+            return 0; // 空文件，或写文件头时中断
+        }
+        if (!std::equal(kMagic, kMagic + 4, data.data())) {
+            throw std::runtime_error("日志文件格式错误: " + filename);
+        }
+        size_t pos = kFileHeaderSize;
+        while (data.size() - pos >= kEntryHeaderSize) {
+            uint32_t length, checksum;
+            std::memcpy(&length, data.data() + pos, sizeof(length));
+            std::memcpy(&checksum, data.data() + pos + 4, sizeof(checksum));
+            if (data.size() - pos - kEntryHeaderSize < length) {
+                break;
+            }
+            const char* body = data.data() + pos + kEntryHeaderSize;
+            if (entryChecksum(body, length) != checksum) {
+                break;
+            }
+            BinaryReader reader(body, length);
+            apply(reader);
+            pos += kEntryHeaderSize + length;
+        }
+        return pos;
+    }
+
+public:
+    ResourceJournal(ResourceCollection& c, std::string snapshot = "resources.dat",
+                    std::string journalPath = "resources.journal")
+        : collection(c), snapshotFile(std::move(snapshot)), journalFile(std::move(journalPath)) {
+        collection.addStatusObserver(this);
+    }
+
+    ResourceJournal(const ResourceJournal&) = delete;
+    ResourceJournal& operator=(const ResourceJournal&) = delete;
+
+    ~ResourceJournal() override {
+        collection.removeStatusObserver(this);
+        joinCompactor();
+        if (compactionError) {
+            // 析构时无法抛出；旧日志仍在磁盘上，下次 load() 会合并它
+            std::cerr << "压缩资源日志失败，将在下次加载时重试" << std::endl;
+        }
+    }
+
+    // 读取快照并重放日志；快照不存在时从空集合开始
+    void load() {
+        joinCompactor();
+        compactionError = nullptr; // 以磁盘上的状态为准重新加载
+        journal.close();
+        if (std::filesystem::exists(snapshotFile)) {
+            collection.loadFromFile(snapshotFile);
+            snapshotBytes = std::filesystem::file_size(snapshotFile);
+        } else {
+            collection.clear();
+            snapshotBytes = 0;
+        }
+        bool hasOld = std::filesystem::exists(oldJournalFile());
+        replaying = true;
+        try {
+            if (hasOld) {
+                replay(oldJournalFile());
+            }
+            if (std::filesystem::exists(journalFile)) {
+                uint64_t valid = replay(journalFile);
+                if (valid < std::filesystem::file_size(journalFile)) {
+                    std::filesystem::resize_file(journalFile, valid);
+                }
+            }
+        } catch (...) {
+            replaying = false;
+            throw;
+        }
+        replaying = false;
+        openJournal();
+        if (hasOld) {
+            // 上次压缩未完成，立即同步压缩以合并旧日志
+            compact();
+        }
+    }
+
+    // 记录变更
+    void logAdd(const Resource& resource) {
+        BinaryWriter writer(128);
+        writer.put(static_cast<uint8_t>(JournalOp::ADD));
+        writer.put(static_cast<uint8_t>(resource.getResourceType()));
+        resource.serialize(writer);
+        append(writer.payload());
+    }
+
+    void logModify(const std::string& id, const std::string& newName, double newRate) {
+        BinaryWriter writer(128);
+        writer.put(static_cast<uint8_t>(JournalOp::MODIFY));
+        writer.putString(id);
+        writer.putString(newName);
+        writer.put(newRate);
+        append(writer.payload());
+    }
+
+    void logRemove(const std::string& id) {
+        BinaryWriter writer(64);
+        writer.put(static_cast<uint8_t>(JournalOp::REMOVE));
+        writer.putString(id);
+        append(writer.payload());
+    }
+
+    void logStatus(const std::string& id, ResourceStatus status) {
+        BinaryWriter writer(64);
+        writer.put(static_cast<uint8_t>(JournalOp::STATUS));
+        writer.putString(id);
+        writer.put(static_cast<uint8_t>(status));
+        append(writer.payload());
+    }
+
+    // 集合中资源状态变更时记录；回调不能抛出，写入失败只报告错误
+    void onResourceStatusChanged(const Resource& resource, ResourceStatus) override {
+        if (replaying) {
+            return;
+        }
+        try {
+            logStatus(resource.getResourceId(), resource.getStatus());
+        } catch (const std::exception& e) {
+            std::cerr << "记录资源状态失败: " << e.what() << std::endl;
+        }
+    }
+
+    void logTypeRate(ResourceType type, double newRate) {
+        BinaryWriter writer(64);
+        writer.put(static_cast<uint8_t>(JournalOp::TYPE_RATE));
+        writer.put(static_cast<uint8_t>(type));
+        writer.put(newRate);
+        append(writer.payload());
+    }
+
+    // 压缩：前台序列化当前状态并切换日志，后台写快照并删除旧日志
+    // 旧日志仍存在时改为同步写快照，失败时抛出异常，日志保持不变
+    void compact() {
+        joinCompactor();
+        auto snapshot = std::make_shared<BinaryWriter>(collection.snapshot());
+        uint64_t count = collection.size();
+        std::string old = oldJournalFile();
+
+        if (std::filesystem::exists(old)) {
+            writeSnapshot(*snapshot, snapshotFile, count);
+            compactionError = nullptr;
+            snapshotBytes = snapshot->size();
+            // 快照已包含旧日志和当前日志中的全部修改
+            std::filesystem::remove(old);
+            journal.close();
+            std::filesystem::resize_file(journalFile, 0);
+            openJournal();
+            return;
+        }
+
+        journal.close();
+        if (std::rename(journalFile.c_str(), old.c_str()) != 0) {
+            openJournal();
+            throw std::runtime_error("无法切换日志文件: " + journalFile);
+        }
+        openJournal();
+        snapshotBytes = snapshot->size();
+
+        std::string target = snapshotFile;
+        compactor = std::thread([this, snapshot, count, target, old]() {
+            try {
+                writeSnapshot(*snapshot, target, count);
+                std::filesystem::remove(old);
+            } catch (...) {
+                compactionError = std::current_exception();
+            }
+        });
+    }
+
+    // 等待后台压缩结束；压缩失败时抛出该异常（旧日志保留，下次压缩会同步合并）
+    void waitForCompaction() {
+        joinCompactor();
+        if (compactionError) {
+            std::exception_ptr error = compactionError;
+            compactionError = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    uint64_t getJournalBytes() const { return journalBytes; }
+};
+
+#endif // RESOURCE_JOURNAL_HPP
@@ -0,0 +1,164 @@
+// ResourceSlotMap.hpp
+#ifndef RESOURCE_SLOT_MAP_HPP
+#define RESOURCE_SLOT_MAP_HPP
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+class Resource;
+
+/**
+ * @struct ResourceHandle
+ * @brief 指向资源槽位的句柄：槽位下标 + 代数。
+ *
+ * 槽位被删除或重用时代数递增，旧句柄随即失效，解析时返回空。
+ * 句柄只是两个整数，租赁记录和索引可以直接保存，无需反复按字符串ID查找。
+ */
+struct ResourceHandle {
+    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == kInvalidIndex; }
+    bool operator==(const ResourceHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const ResourceHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @class ResourceSlotMap
+ * @brief 以槽位数组存放资源的容器。
+ *
+ * 删除只把槽位标记为墓碑（释放对象、代数加一、下标放入空闲链表），O(1)，不移动其他元素；
+ * 插入优先重用空闲槽位。墓碑过多时可调用 compact() 把存活元素紧凑到数组前部，
+ * 被移动元素的句柄会改变，通过回调告知调用方更新。
+ */
+class ResourceSlotMap {
+private:
+    struct Slot {
+        std::shared_ptr<Resource> resource; // 为空表示墓碑
+        uint32_t generation = 0;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeList;
+    size_t liveCount = 0;
+    uint32_t freshGeneration = 0; // 新建槽位的起始代数，大于所有被截掉槽位用过的代数
+
+public:
+    ResourceHandle insert(std::shared_ptr<Resource> resource) {
+        uint32_t index;
+        if (!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        } else {
+            index = static_cast<uint32_t>(slots.size());
+            slots.emplace_back();
+            slots[index].generation = freshGeneration;
+        }
+        slots[index].resource = std::move(resource);
+        ++liveCount;
+        return ResourceHandle{index, slots[index].generation};
+    }
+
+    bool contains(ResourceHandle handle) const {
+        return handle.index < slots.size() && slots[handle.index].generation == handle.generation &&
+               slots[handle.index].resource != nullptr;
+    }
+
+    // 解析句柄，失效时返回空
+    const std::shared_ptr<Resource>& get(ResourceHandle handle) const {
+        static const std::shared_ptr<Resource> none;
+        return contains(handle) ? slots[handle.index].resource : none;
+    }
+
+    bool erase(ResourceHandle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        Slot& slot = slots[handle.index];
+        slot.resource.reset();
+        ++slot.generation;
+        freeList.push_back(handle.index);
+        --liveCount;
+        return true;
+    }
+
+    void clear() {
+        for (const auto& slot : slots) {
+            freshGeneration = std::max(freshGeneration, slot.generation + 1);
+        }
+        slots.clear();
+        freeList.clear();
+        liveCount = 0;
+    }
+
+    void reserve(size_t n) { slots.reserve(n); }
+
+    size_t size() const { return liveCount; }
+    size_t capacity() const { return slots.size(); }
+    size_t tombstoneCount() const { return slots.size() - liveCount; }
+
+    // 按槽位顺序遍历存活元素，回调参数为 (句柄, 资源指针)
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (uint32_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].resource) {
+                visit(ResourceHandle{i, slots[i].generation}, slots[i].resource);
+            }
+        }
+    }
+
+    // 按槽位顺序遍历第 offset 个起的至多 limit 个存活元素；
+    // 没有墓碑时直接从第 offset 个槽位开始，代价只与 limit 有关
+    template <typename Visitor>
+    void forEachInRange(size_t offset, size_t limit, Visitor visit) const {
+        size_t i = 0;
+        if (freeList.empty()) {
+            i = std::min(offset, slots.size());
+        } else {
+            for (size_t skipped = 0; i < slots.size() && skipped < offset; ++i) {
+                skipped += slots[i].resource != nullptr;
+            }
+        }
+        for (size_t visited = 0; i < slots.size() && visited < limit; ++i) {
+            if (slots[i].resource) {
+                visit(ResourceHandle{static_cast<uint32_t>(i), slots[i].generation}, slots[i].resource);
+                ++visited;
+            }
+        }
+    }
+
+    // 紧凑：存活元素依次移到前部，截掉尾部墓碑，回调参数为 (旧句柄, 新句柄)
+    // 被移出的槽位代数加一，持有旧句柄者解析时得到空而不会误指向其他资源
+    template <typename Remap>
+    void compact(Remap remap) {
+        uint32_t target = 0;
+        for (uint32_t i = 0; i < slots.size(); ++i) {
+            if (!slots[i].resource) {
+                continue;
+            }
+            if (i != target) {
+                ResourceHandle from{i, slots[i].generation};
+                slots[target].resource = std::move(slots[i].resource);
+                ++slots[target].generation;
+                ++slots[i].generation;
+                remap(from, ResourceHandle{target, slots[target].generation});
+            }
+            ++target;
+        }
+        for (uint32_t i = target; i < slots.size(); ++i) {
+            freshGeneration = std::max(freshGeneration, slots[i].generation + 1);
+        }
+        slots.resize(target);
+        slots.shrink_to_fit();
+        freeList.clear();
+    }
+};
+
+#endif // RESOURCE_SLOT_MAP_HPP
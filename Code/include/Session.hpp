@@ -0,0 +1,170 @@
+// Session.hpp
+#ifndef SESSION_HPP
+#define SESSION_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include "User.hpp"
+
+/**
+ * @struct Session
+ * @brief 一次登录产生的会话。
+ *
+ * 缓存用户对象、角色和状态，鉴权时无需再查用户集合或校验密码。
+ */
+struct Session {
+    std::shared_ptr<User> user;
+    UserRole role;
+    UserStatus status;
+    std::chrono::steady_clock::time_point expiresAt;
+};
+
+/**
+ * @class SessionManager
+ * @brief 会话令牌缓存。
+ *
+ * 登录成功时签发随机令牌，之后每次操作凭令牌做一次哈希查找即可得到会话，
+ * 过期的会话在被访问或 purgeExpired() 时删除。
+ * 注册为管理员的用户状态监听者后，用户被暂停时其全部会话立即吊销。
+ * 非线程安全。
+ */
+class SessionManager : public UserStatusListener {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    std::chrono::seconds ttl;
+    std::unordered_map<std::string, Session> sessions;               // 令牌 -> 会话
+    std::unordered_map<std::string, std::vector<std::string>> byUser; // 用户ID -> 令牌
+    std::random_device entropy; // 非确定性熵源；不能用伪随机数发生器，少量令牌即可反推其种子
+
+    // 128位随机数的十六进制表示，每个令牌都直接取自熵源
+    std::string newToken() {
+        static const char digits[] = "0123456789abcdef";
+        static_assert(sizeof(std::random_device::result_type) >= 4, "每次至少取32位熵");
+        std::string token(32, '0');
+        for (int word = 0; word < 4; ++word) {
+            uint32_t bits = static_cast<uint32_t>(entropy());
+            for (int i = 0; i < 8; ++i) {
+                token[word * 8 + i] = digits[bits & 0xF];
+                bits >>= 4;
+            }
+        }
+        return token;
+    }
+
+    void forgetToken(const std::string& userId, const std::string& token) {
+        auto it = byUser.find(userId);
+        if (it == byUser.end()) {
+            return;
+        }
+        auto& tokens = it->second;
+        tokens.erase(std::remove(tokens.begin(), tokens.end(), token), tokens.end());
+        if (tokens.empty()) {
+            byUser.erase(it);
+        }
+    }
+
+public:
+    explicit SessionManager(std::chrono::seconds timeToLive = std::chrono::hours(8))
+        : ttl(timeToLive) {}
+
+    // 为已通过验证的用户签发令牌
+    std::string issue(const std::shared_ptr<User>& user, Clock::time_point now = Clock::now()) {
+        std::string token = newToken();
+        while (sessions.count(token)) {
+            token = newToken();
+        }
+        sessions.emplace(token, Session{user, user->getRole(), user->getStatus(), now + ttl});
+        byUser[user->getUserId()].push_back(token);
+        return token;
+    }
+
+    // 用户名密码登录，成功返回令牌；凭据错误或用户已暂停时返回空字符串
+    std::string login(const UserCollection& users, const std::string& name, const std::string& password,
+                      Clock::time_point now = Clock::now()) {
+        auto user = users.login(name, password);
+        if (!user || user->getStatus() != UserStatus::ACTIVE) {
+            return "";
+        }
+        return issue(user, now);
+    }
+
+    // 解析令牌，无效或已过期返回nullptr；返回的指针在下一次修改会话前有效
+    const Session* resolve(const std::string& token, Clock::time_point now = Clock::now()) {
+        auto it = sessions.find(token);
+        if (it == sessions.end()) {
+            return nullptr;
+        }
+        if (it->second.expiresAt <= now) {
+            forgetToken(it->second.user->getUserId(), token);
+            sessions.erase(it);
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    // 登出
+    bool revoke(const std::string& token) {
+        auto it = sessions.find(token);
+        if (it == sessions.end()) {
+            return false;
+        }
+        forgetToken(it->second.user->getUserId(), token);
+        sessions.erase(it);
+        return true;
+    }
+
+    // 吊销某用户的全部会话，返回吊销数量
+    size_t revokeUser(const std::string& userId) {
+        auto it = byUser.find(userId);
+        if (it == byUser.end()) {
+            return 0;
+        }
+        size_t count = it->second.size();
+        for (const auto& token : it->second) {
+            sessions.erase(token);
+        }
+        byUser.erase(it);
+        return count;
+    }
+
+    // 删除所有已过期的会话，返回删除数量
+    size_t purgeExpired(Clock::time_point now = Clock::now()) {
+        size_t count = 0;
+        for (auto it = sessions.begin(); it != sessions.end();) {
+            if (it->second.expiresAt <= now) {
+                forgetToken(it->second.user->getUserId(), it->first);
+                it = sessions.erase(it);
+                ++count;
+            } else {
+                ++it;
+            }
+        }
+        return count;
+    }
+
+    size_t size() const { return sessions.size(); }
+
+    // 用户被暂停时吊销其会话，其他状态变化只同步缓存
+    void onUserStatusChanged(const User& user, UserStatus) override {
+        if (user.getStatus() == UserStatus::SUSPENDED) {
+            revokeUser(user.getUserId());
+            return;
+        }
+        auto it = byUser.find(user.getUserId());
+        if (it != byUser.end()) {
+            for (const auto& token : it->second) {
+                sessions.at(token).status = user.getStatus();
+            }
+        }
+    }
+};
+
+#endif // SESSION_HPP
@@ -0,0 +1,192 @@
+// Settlement.hpp
+#ifndef SETTLEMENT_HPP
+#define SETTLEMENT_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include "BalanceLedger.hpp"
+#include "Rental.hpp"
+#include "User.hpp"
+
+// 一笔待结算的费用
+struct Charge {
+    std::string userId;
+    std::string rentalId;
+    Money amount; // 分，不得为负
+
+    // 由已完成的租赁记录生成
+    static Charge fromRental(const RentalRecord& record) {
+        return Charge{record.userId, record.rentalId, toMinorUnits(record.totalCost)};
+    }
+};
+
+// 单个用户的结算结果
+enum class SettlementOutcome {
+    SUCCESS,            // 全部费用已扣除
+    PARTIAL,            // 余额只够支付其中一部分费用
+    INSUFFICIENT_FUNDS, // 一笔也付不起
+    UNKNOWN_USER        // 用户不存在
+};
+
+struct SettlementResult {
+    std::string userId;
+    SettlementOutcome outcome;
+    Money charged = 0;  // 已扣除金额
+    Money unpaid = 0;   // 未能扣除金额
+    size_t paidCount = 0;
+    size_t chargeCount = 0;
+    Money balanceAfter = 0;
+};
+
+// 结算后余额低于阈值的提醒
+struct LowBalanceEvent {
+    std::string userId;
+    Money balance;
+};
+
+struct SettlementReport {
+    std::vector<SettlementResult> results;     // 每个用户一条，按用户首次出现的顺序
+    std::vector<uint8_t> paid;                 // 与输入费用一一对应，1表示已扣除
+    std::vector<size_t> rejected;              // 金额为负、未参与结算的费用下标
+    std::vector<LowBalanceEvent> lowBalance;   // 全部扣款完成后统一生成
+};
+
+/**
+ * @class SettlementEngine
+ * @brief 批量结算：一次处理一批费用。
+ *
+ * 金额为负的费用视为无效输入，不参与结算，下标记入 SettlementReport::rejected。
+ * 其余费用先按用户分组（哈希分组 + 计数分桶，保持同一用户费用的原始顺序），
+ * 每个用户只查找一次，并以一次原子扣款支付其全部费用；
+ * 余额不足时按原始顺序挑出付得起的费用合并扣除，其余记为未付。
+ * 余额提醒在所有扣款完成后统一生成，不穿插在扣款过程中。
+ * 扣款通过 BalanceAccount 完成，可与其他线程的存取款并发进行。
+ */
+class SettlementEngine {
+private:
+    Money lowBalanceThreshold;
+
+    // 在当前余额下挑出付得起的费用并一次扣除；只有余额被并发修改时才重新挑选
+    static Money payWhatFits(BalanceAccount& account, const Charge* charges, const uint32_t* order,
+                             size_t count, std::vector<uint8_t>& paid) {
+        return account.withdrawPicked([&](Money available) {
+            Money left = available;
+            Money total = 0;
+            for (size_t i = 0; i < count; ++i) {
+                Money amount = charges[order[i]].amount;
+                bool fits = amount <= left;
+                paid[order[i]] = fits;
+                left -= fits ? amount : 0;
+                total += fits ? amount : 0;
+            }
+            return total;
+        });
+    }
+
+public:
+    explicit SettlementEngine(Money threshold = toMinorUnits(10.0)) : lowBalanceThreshold(threshold) {}
+
+    void setLowBalanceThreshold(Money threshold) { lowBalanceThreshold = threshold; }
+
+    SettlementReport settle(const UserCollection& users, const Charge* charges, size_t count) const {
+        SettlementReport report;
+        report.paid.assign(count, 0);
+
+        // 第一遍：为每个用户分配组号并统计组内费用数
+        std::unordered_map<std::string_view, uint32_t> groupOf;
+        groupOf.reserve(std::min(count, users.size()));
+        std::vector<uint32_t> groupIds(count);
+        std::vector<uint32_t> offsets;
+        const uint32_t kRejected = UINT32_MAX;
+        for (size_t i = 0; i < count; ++i) {
+            if (charges[i].amount < 0) {
+                groupIds[i] = kRejected;
+                report.rejected.push_back(i);
+                continue;
+            }
+            // try_emplace 在键已存在时不分配节点
+            auto inserted = groupOf.try_emplace(charges[i].userId, static_cast<uint32_t>(offsets.size()));
+            if (inserted.second) {
+                offsets.push_back(0);
+            }
+            groupIds[i] = inserted.first->second;
+            ++offsets[groupIds[i]];
+        }
+
+        // 第二遍：计数分桶，得到按用户连续排列的费用下标
+        size_t groups = offsets.size();
+        uint32_t running = 0;
+        for (auto& offset : offsets) {
+            uint32_t size = offset;
+            offset = running;
+            running += size;
+        }
+        offsets.push_back(running);
+        std::vector<uint32_t> order(running);
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < count; ++i) {
+            if (groupIds[i] != kRejected) {
+                order[cursor[groupIds[i]]++] = static_cast<uint32_t>(i);
+            }
+        }
+
+        // 第三遍：逐个用户扣款
+        report.results.resize(groups);
+        for (size_t g = 0; g < groups; ++g) {
+            const uint32_t* group = order.data() + offsets[g];
+            size_t size = offsets[g + 1] - offsets[g];
+            SettlementResult& result = report.results[g];
+            result.userId = charges[group[0]].userId;
+            result.chargeCount = size;
+
+            Money total = 0;
+            for (size_t i = 0; i < size; ++i) {
+                total += charges[group[i]].amount;
+            }
+
+            auto user = users.findUserById(result.userId);
+            if (!user) {
+                result.outcome = SettlementOutcome::UNKNOWN_USER;
+                result.unpaid = total;
+                continue;
+            }
+            BalanceAccount& account = user->getAccount();
+            if (account.withdraw(total)) {
+                for (size_t i = 0; i < size; ++i) {
+                    report.paid[group[i]] = 1;
+                }
+                result.charged = total;
+                result.paidCount = size;
+            } else {
+                result.charged = payWhatFits(account, charges, group, size, report.paid);
+                for (size_t i = 0; i < size; ++i) {
+                    result.paidCount += report.paid[group[i]];
+                }
+            }
+            result.unpaid = total - result.charged;
+            result.balanceAfter = account.getAvailable();
+            result.outcome = result.paidCount == size ? SettlementOutcome::SUCCESS
+                           : result.paidCount == 0    ? SettlementOutcome::INSUFFICIENT_FUNDS
+                                                      : SettlementOutcome::PARTIAL;
+        }
+
+        // 全部扣款完成后统一生成余额提醒
+        for (const auto& result : report.results) {
+            if (result.outcome != SettlementOutcome::UNKNOWN_USER && result.balanceAfter < lowBalanceThreshold) {
+                report.lowBalance.push_back(LowBalanceEvent{result.userId, result.balanceAfter});
+            }
+        }
+        return report;
+    }
+
+    SettlementReport settle(const UserCollection& users, const std::vector<Charge>& charges) const {
+        return settle(users, charges.data(), charges.size());
+    }
+};
+
+#endif // SETTLEMENT_HPP
@@ -0,0 +1,369 @@
+// TimerWheel.hpp
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include "Rental.hpp"
+
+using TimerTick = uint64_t;
+
+// 定时器句柄：下标 + 代数，定时器触发或取消后句柄失效
+struct TimerHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != UINT32_MAX; }
+};
+
+/**
+ * @class TimerWheel
+ * @brief 分层时间轮。
+ *
+ * 共 11 层，每层 64 个槽，覆盖完整的 64 位 tick 范围。
+ * 定时器放在到期 tick 与当前 tick 最高不同位所在的层，
+ * 当前 tick 走到该层对应槽的起点时整槽下放到更低层，第 0 层的槽到点即触发。
+ * 每层用一个 64 位掩码记录非空槽，推进时直接跳到下一个非空槽，
+ * 空闲的 tick 不产生任何开销。
+ * 插入、取消为 O(1)，每个定时器在触发前最多被下放 10 次。
+ * 节点存放在连续数组中，槽内为双向链表，释放的节点经空闲链表复用。
+ * 非线程安全。
+ */
+template <typename Payload>
+class TimerWheel {
+private:
+    static constexpr unsigned kSlotBits = 6;
+    static constexpr unsigned kSlots = 1u << kSlotBits;
+    static constexpr unsigned kLevels = (64 + kSlotBits - 1) / kSlotBits;
+    static constexpr uint32_t kNone = UINT32_MAX;
+    static constexpr uint8_t kFiring = 0xFF; // 已从槽中取出、等待本轮触发
+
+    struct Node {
+        TimerTick deadline = 0;
+        Payload payload{};
+        uint32_t prev = kNone;
+        uint32_t next = kNone;
+        uint32_t generation = 0;
+        uint8_t level = 0;
+        bool active = false;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> freeList;
+    std::array<std::array<uint32_t, kSlots>, kLevels> heads;
+    std::array<uint64_t, kLevels> occupied{};
+    std::vector<uint32_t> firing; // 复用的触发缓冲
+    TimerTick current = 0;
+    size_t count = 0;
+
+    static unsigned slotOf(TimerTick tick, unsigned level) {
+        return static_cast<unsigned>(tick >> (level * kSlotBits)) & (kSlots - 1);
+    }
+
+    static unsigned highestBit(uint64_t value) { return 63u - static_cast<unsigned>(__builtin_clzll(value)); }
+
+    void link(uint32_t index) {
+        Node& node = nodes[index];
+        // 下放时到期 tick 可能恰为当前 tick，放入第 0 层当前槽随即触发
+        TimerTick diff = node.deadline ^ current;
+        unsigned level = diff == 0 ? 0 : highestBit(diff) / kSlotBits;
+        unsigned slot = slotOf(node.deadline, level);
+        node.level = static_cast<uint8_t>(level);
+        node.prev = kNone;
+        node.next = heads[level][slot];
+        if (node.next != kNone) {
+            nodes[node.next].prev = index;
+        }
+        heads[level][slot] = index;
+        occupied[level] |= uint64_t(1) << slot;
+    }
+
+    void unlink(uint32_t index) {
+        Node& node = nodes[index];
+        unsigned slot = slotOf(node.deadline, node.level);
+        if (node.prev != kNone) {
+            nodes[node.prev].next = node.next;
+        } else {
+            heads[node.level][slot] = node.next;
+            if (node.next == kNone) {
+                occupied[node.level] &= ~(uint64_t(1) << slot);
+            }
+        }
+        if (node.next != kNone) {
+            nodes[node.next].prev = node.prev;
+        }
+    }
+
+    void release(uint32_t index) {
+        Node& node = nodes[index];
+        node.active = false;
+        node.payload = Payload{};
+        ++node.generation;
+        freeList.push_back(index);
+        --count;
+    }
+
+    // 取下整个槽的链表
+    uint32_t detach(unsigned level, unsigned slot) {
+        uint32_t head = heads[level][slot];
+        heads[level][slot] = kNone;
+        occupied[level] &= ~(uint64_t(1) << slot);
+        return head;
+    }
+
+    // 下一个需要处理的 tick（某层非空槽的起点），没有定时器时返回 false
+    bool nextDue(TimerTick& due) const {
+        bool found = false;
+        for (unsigned level = 0; level < kLevels; ++level) {
+            unsigned slot = slotOf(current, level);
+            uint64_t mask = slot + 1 < kSlots ? occupied[level] & (~uint64_t(0) << (slot + 1)) : 0;
+            if (mask == 0) {
+                continue;
+            }
+            unsigned shift = (level + 1) * kSlotBits;
+            TimerTick prefix = shift < 64 ? (current >> shift) << shift : 0;
+            TimerTick tick = prefix | (TimerTick(__builtin_ctzll(mask)) << (level * kSlotBits));
+            if (!found || tick < due) {
+                due = tick;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+public:
+    TimerWheel() {
+        for (auto& level : heads) {
+            level.fill(kNone);
+        }
+    }
+
+    // 在 deadline 触发；不晚于当前 tick 的定时器在下一个 tick 触发
+    TimerHandle schedule(TimerTick deadline, Payload payload) {
+        uint32_t index;
+        if (!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        } else {
+            index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        Node& node = nodes[index];
+        node.deadline = deadline > current ? deadline : current + 1;
+        node.payload = std::move(payload);
+        node.active = true;
+        link(index);
+        ++count;
+        return TimerHandle{index, node.generation};
+    }
+
+    bool cancel(TimerHandle handle) {
+        if (!handle.valid() || handle.index >= nodes.size()) {
+            return false;
+        }
+        Node& node = nodes[handle.index];
+        if (!node.active || node.generation != handle.generation) {
+            return false;
+        }
+        if (node.level == kFiring) {
+            // 已取出待触发，由触发循环回收
+            node.active = false;
+            return true;
+        }
+        unlink(handle.index);
+        release(handle.index);
+        return true;
+    }
+
+    // 推进到 target，按到期 tick 依次触发定时器（同一 tick 内顺序不定），回调参数为 const Payload&。
+    // 回调中可以安排或取消定时器
+    template <typename Visitor>
+    size_t advance(TimerTick target, Visitor fire) {
+        size_t fired = 0;
+        TimerTick due = 0;
+        while (count > 0 && nextDue(due) && due <= target) {
+            current = due;
+            // 先从高层往低层下放，再触发第 0 层
+            for (unsigned level = kLevels - 1; level > 0; --level) {
+                if ((current & ((TimerTick(1) << (level * kSlotBits)) - 1)) != 0) {
+                    continue;
+                }
+                unsigned slot = slotOf(current, level);
+                if (!(occupied[level] & (uint64_t(1) << slot))) {
+                    continue;
+                }
+                for (uint32_t index = detach(level, slot); index != kNone;) {
+                    uint32_t next = nodes[index].next;
+                    link(index);
+                    index = next;
+                }
+            }
+            unsigned slot = slotOf(current, 0);
+            if (!(occupied[0] & (uint64_t(1) << slot))) {
+                continue;
+            }
+            firing.clear();
+            for (uint32_t index = detach(0, slot); index != kNone; index = nodes[index].next) {
+                nodes[index].level = kFiring;
+                firing.push_back(index);
+            }
+            for (size_t i = 0; i < firing.size(); ++i) {
+                uint32_t index = firing[i];
+                if (nodes[index].active) {
+                    Payload payload = std::move(nodes[index].payload);
+                    release(index);
+                    fire(static_cast<const Payload&>(payload));
+                    ++fired;
+                } else {
+                    nodes[index].active = true; // 取消时未回收，此处统一回收
+                    release(index);
+                }
+            }
+        }
+        if (target > current) {
+            current = target;
+        }
+        return fired;
+    }
+
+    TimerTick now() const { return current; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+// 租赁相关的定时事件
+enum class RentalTimerKind : uint8_t {
+    EXPIRY,   // 待审批请求过期
+    START,    // 已批准的租赁开始
+    REMINDER, // 即将到期提醒
+    END       // 租赁结束
+};
+constexpr size_t kRentalTimerKindCount = 4;
+
+struct RentalTimer {
+    RentalTimerKind kind = RentalTimerKind::EXPIRY;
+    std::string id; // EXPIRY/START 为请求ID，REMINDER/END 为租赁ID
+};
+
+/**
+ * @class RentalTimers
+ * @brief 用时间轮驱动 updateRentalStatuses。
+ *
+ * 为每个请求/租赁登记过期、开始、提醒、结束时间，
+ * advance 只回调到期的事件，由调用方完成 PENDING_APPROVAL→EXPIRED、
+ * APPROVED→ACTIVE、ACTIVE→COMPLETED 转换和到期提醒，
+ * 不再每次遍历全部请求和租赁。时间精度默认为一分钟，到期时间向上取整。
+ */
+class RentalTimers {
+private:
+    using Clock = std::chrono::system_clock;
+
+    TimerWheel<RentalTimer> wheel;
+    Clock::time_point origin;
+    Clock::duration resolution;
+    using HandleMap = std::unordered_map<std::string, std::array<TimerHandle, kRentalTimerKindCount>>;
+    // 请求ID和租赁ID可能相同，分开存放，互不覆盖
+    HandleMap requestHandles; // EXPIRY、START
+    HandleMap rentalHandles;  // REMINDER、END
+
+    TimerTick toTick(Clock::time_point time) const {
+        if (time <= origin) {
+            return 0;
+        }
+        return static_cast<TimerTick>((time - origin + resolution - Clock::duration(1)) / resolution);
+    }
+
+    static bool isRequestTimer(RentalTimerKind kind) {
+        return kind == RentalTimerKind::EXPIRY || kind == RentalTimerKind::START;
+    }
+
+    HandleMap& handlesFor(RentalTimerKind kind) { return isRequestTimer(kind) ? requestHandles : rentalHandles; }
+
+    void arm(RentalTimerKind kind, const std::string& id, Clock::time_point when) {
+        TimerHandle& handle = handlesFor(kind)[id][static_cast<size_t>(kind)];
+        wheel.cancel(handle);
+        handle = wheel.schedule(toTick(when), RentalTimer{kind, id});
+    }
+
+    void disarm(RentalTimerKind kind, const std::string& id) {
+        HandleMap& handles = handlesFor(kind);
+        auto it = handles.find(id);
+        if (it != handles.end()) {
+            wheel.cancel(it->second[static_cast<size_t>(kind)]);
+            it->second[static_cast<size_t>(kind)] = TimerHandle{};
+        }
+    }
+
+    // 取消某个请求或租赁的全部定时事件
+    void cancelAll(HandleMap& handles, const std::string& id) {
+        auto it = handles.find(id);
+        if (it == handles.end()) {
+            return;
+        }
+        for (TimerHandle handle : it->second) {
+            wheel.cancel(handle);
+        }
+        handles.erase(it);
+    }
+
+public:
+    explicit RentalTimers(Clock::time_point start = Clock::now(),
+                          Clock::duration tickLength = std::chrono::minutes(1))
+        : origin(start), resolution(tickLength) {}
+
+    // 新的待审批请求：到期望开始时间仍未审批则过期
+    void onRequestCreated(const RentalRequest& request) {
+        arm(RentalTimerKind::EXPIRY, request.requestId, request.desiredStartTime);
+    }
+
+    // 请求已批准：取消过期，到期望开始时间时开始
+    void onRequestApproved(const RentalRequest& request) {
+        disarm(RentalTimerKind::EXPIRY, request.requestId);
+        arm(RentalTimerKind::START, request.requestId, request.desiredStartTime);
+    }
+
+    // 请求被拒绝或取消
+    void onRequestClosed(const std::string& requestId) { cancelAll(requestHandles, requestId); }
+
+    // 租赁开始：登记结束时间和提前 reminderLead 的提醒
+    void onRentalStarted(const RentalRecord& record, std::chrono::hours duration,
+                         Clock::duration reminderLead = std::chrono::hours(1)) {
+        Clock::time_point end = record.actualStartTime + duration;
+        arm(RentalTimerKind::END, record.rentalId, end);
+        if (end - reminderLead > record.actualStartTime) {
+            arm(RentalTimerKind::REMINDER, record.rentalId, end - reminderLead);
+        }
+    }
+
+    // 租赁提前结束：取消提醒和结束事件
+    void onRentalClosed(const std::string& rentalId) { cancelAll(rentalHandles, rentalId); }
+
+    // 推进到 now，回调参数为 const RentalTimer&，返回触发的事件数
+    template <typename Visitor>
+    size_t advance(Clock::time_point now, Visitor fire) {
+        TimerTick target = now <= origin ? 0 : static_cast<TimerTick>((now - origin) / resolution);
+        return wheel.advance(target, [this, &fire](const RentalTimer& timer) {
+            HandleMap& handles = handlesFor(timer.kind);
+            auto it = handles.find(timer.id);
+            if (it != handles.end()) {
+                it->second[static_cast<size_t>(timer.kind)] = TimerHandle{};
+                bool idle = true;
+                for (TimerHandle handle : it->second) {
+                    idle = idle && !handle.valid();
+                }
+                if (idle) {
+                    handles.erase(it);
+                }
+            }
+            fire(timer);
+        });
+    }
+
+    size_t size() const { return wheel.size(); }
+};
+
+#endif // TIMER_WHEEL_HPP
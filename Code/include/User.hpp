@@ -6,7 +6,13 @@
 #include <iostream>
 #include <memory>
 #include <fstream> // 添加文件流头文件
+#include <array>
+#include <unordered_map> // 用户ID/用户名哈希索引
+#include "ParallelFor.hpp"
 #include "Resource.hpp"
+#include "ResourceJournal.hpp"
+#include "ConcurrentResourceCollection.hpp"
+#include "BalanceLedger.hpp"
 // #include "Rental.hpp" // 后续如需租赁历史记录，可前向声明或包含
 
 // 还需要解决初始化自动编号的问题
@@ -17,6 +23,7 @@ enum class UserRole {
     TEACHER,
     ADMIN
 };
+constexpr size_t kUserRoleCount = 3;
 
 
 // 用户状态枚举
@@ -40,6 +47,20 @@ const char* UserStatusToString(UserStatus status) {
         default: return "未知状态";
     }
 }
+class User;
+
+/**
+ * @class UserStatusListener
+ * @brief 用户状态变更的监听接口。
+ *
+ * 管理员修改用户状态后回调，例如会话管理器据此吊销被暂停用户的会话。
+ */
+class UserStatusListener {
+public:
+    virtual ~UserStatusListener() = default;
+    virtual void onUserStatusChanged(const User& user, UserStatus oldStatus) = 0;
+};
+
 /**
  * @class User
  * @brief 系统中所有用户的基类。
@@ -56,22 +77,23 @@ protected:
     std::string userId;
     std::string username;
     std::string Password; 
-    double accountBalance;
+    BalanceAccount account; // 余额，单位为分
     UserStatus status;
     UserRole role;
     // std::vector<RentalRecord> rentalHistory; // 可选，或由租赁系统管理
 
 public:
     // 构造函数
-    User(std::string id, std::string name, std::string password,  double balance = 0.0, UserRole r,UserStatus stat = UserStatus::ACTIVE)
-        : userId(id), username(name), Password(password), accountBalance(balance),role(r), status(stat) {}
+    User(std::string id, std::string name, std::string password,  double balance = 0.0, UserRole r = UserRole::STUDENT,UserStatus stat = UserStatus::ACTIVE)
+        : userId(id), username(name), Password(password), account(toMinorUnits(balance)),role(r), status(stat) {}
     virtual ~User() = default;
 
     // 获取器
     std::string getUserId() const{return userId;}
     std::string getUsername() const{return username;}
     virtual UserRole getRole() const=0;
-    double getAccountBalance() const{return accountBalance;}
+    double getAccountBalance() const{return fromMinorUnits(account.getAvailable());}
+    double getReservedBalance() const{return fromMinorUnits(account.getReserved());}
     UserStatus getStatus() const{return status;};
 
     // 设置器
@@ -79,9 +101,13 @@ public:
     void setPassword(const std::string& newPassword){Password=newPassword;} // 密码修改逻辑
     void setStatus(UserStatus newStatus){status=newStatus;}
 
-    // 账户余额管理
-    virtual void deposit(double amount)=0;
-    virtual bool withdraw(double amount)=0; // 成功返回true
+    // 账户余额管理，可在多个线程中并发调用
+    void deposit(double amount){account.deposit(toMinorUnits(amount));} // 负数金额被忽略
+    bool withdraw(double amount){return account.withdraw(toMinorUnits(amount));} // 成功返回true，余额不足时失败
+
+    // 预留/确认/退还，供计费流程使用
+    BalanceAccount& getAccount(){return account;}
+    const BalanceAccount& getAccount() const{return account;}
 
    
     // 身份验证
@@ -91,30 +117,49 @@ public:
     // 显示用户特定菜单/信息的纯虚函数
     virtual void displayDashboard() const=0;
     // 序列化/反序列化方法（用于数据持久化）
+    // 保存时已预留未确认的金额计入余额，重新加载后相当于全部退还
+    double persistedBalance() const {
+        return fromMinorUnits(account.getAvailable() + account.getReserved());
+    }
+
     virtual void serialize(std::ostream& os) const {
         // 写入基本属性
         os.write(userId.c_str(), userId.size() + 1);
         os.write(username.c_str(), username.size() + 1);
         os.write(Password.c_str(), Password.size() + 1);
-        os.write(reinterpret_cast<const char*>(&accountBalance), sizeof(double));
+        double balance = persistedBalance();
+        os.write(reinterpret_cast<const char*>(&balance), sizeof(double));
         os.write(reinterpret_cast<const char*>(&status), sizeof(UserStatus));
     }
     
     virtual void deserialize(std::istream& is) {
         // 读取基本属性
-        char buffer[256];
-        is.getline(buffer, 256, '\0');
-        userId = buffer;
+        std::getline(is, userId, '\0');
+        std::getline(is, username, '\0');
+        std::getline(is, Password, '\0');
         
-        is.getline(buffer, 256, '\0');
-        username = buffer;
-        
-        is.getline(buffer, 256, '\0');
-        Password = buffer;
-        
-        is.read(reinterpret_cast<char*>(&accountBalance), sizeof(double));
+        double balance = 0;
+        is.read(reinterpret_cast<char*>(&balance), sizeof(double));
+        account.reset(toMinorUnits(balance));
         is.read(reinterpret_cast<char*>(&status), sizeof(UserStatus));
     }
+
+    // v2 格式：定长字段在前，字符串带长度前缀
+    virtual void serialize(BinaryWriter& writer) const {
+        writer.put(static_cast<uint8_t>(status));
+        writer.put(persistedBalance());
+        writer.putString(userId);
+        writer.putString(username);
+        writer.putString(Password);
+    }
+
+    virtual void deserialize(BinaryReader& reader) {
+        status = static_cast<UserStatus>(reader.get<uint8_t>());
+        account.reset(toMinorUnits(reader.get<double>()));
+        userId = reader.getString();
+        username = reader.getString();
+        Password = reader.getString();
+    }
 };
 
 /**
@@ -133,26 +178,12 @@ public:
     Student() : User("", "", "") {}
     
     UserRole getRole() const override{return UserRole::STUDENT;}
-    
-    void deposit(double amount) override{
-        // 还需要增加异常处理
-        if(amount>=0)accountBalance+=amount;
 
-    };
-    bool withdraw(double amount) override{
-        // 还需要增加异常处理
-        if(amount>=0&&amount<=accountBalance){
-            accountBalance-=amount;
-            return true;
-        }
-        return false;
-
-    }
     void displayDashboard() const override {
         std::cout << "===== 学生控制面板 =====\n";
         std::cout << "ID: " << userId << "\n";
         std::cout << "用户名: " << username << "\n";
-        std::cout << "当前余额: " << accountBalance << "\n";
+        std::cout << "当前余额: " << getAccountBalance() << "\n";
         std::cout << "状态: " << (status == UserStatus::ACTIVE? "活跃" : "已暂停") << "\n";
         std::cout << "可用功能:\n";
         std::cout << "1. 浏览资源\n";
@@ -192,24 +223,12 @@ public:
     Teacher() : User("", "", "") {}
     
     UserRole getRole() const override{return UserRole::TEACHER;}
-    
-    void deposit(double amount) override{
-        // 还需要增加异常处理
-        if(amount>=0)accountBalance+=amount;
-    };
-    bool withdraw(double amount) override{
-        // 还需要增加异常处理
-        if(amount>=0&&amount<=accountBalance){
-            accountBalance-=amount;
-            return true;
-        }
-        return false;
-    }
+
     void displayDashboard() const override {
         std::cout << "===== 教师控制面板 =====\n";
         std::cout << "ID: " << userId << "\n";
         std::cout << "用户名: " << username << "\n";
-        std::cout << "当前余额: " << accountBalance << "\n";
+        std::cout << "当前余额: " << getAccountBalance() << "\n";
         std::cout << "状态: " << (status == UserStatus::ACTIVE? "活跃" : "已暂停") << "\n";
         std::cout << "可用功能:\n"; 
         std::cout << "1. 浏览资源\n";
@@ -246,6 +265,27 @@ public:
  *  - 账单模块：设置计费标准，查看所有账单。
  */
 class Admin : public User {
+private:
+    ResourceJournal* resourceJournal = nullptr; // 未设置时每次修改都重写整个 resources.dat
+    ConcurrentResourceCollection* browseCatalog = nullptr; // 设置后每次资源修改都发布为供浏览的新版本
+    UserStatusListener* statusListener = nullptr;
+
+    // 持久化一次资源变更：设置了日志时只追加一条记录，否则整体保存资源文件
+    template <typename LogFn>
+    void persistResourceChange(ResourceCollection& collection, LogFn logToJournal) {
+        try {
+            if (resourceJournal) {
+                logToJournal(*resourceJournal);
+                std::cout << "资源变更已写入日志" << std::endl;
+            } else {
+                collection.saveToFile("resources.dat");
+                std::cout << "资源数据已保存到文件" << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "保存资源数据失败: " << e.what() << std::endl;
+        }
+    }
+
 public:
     Admin(std::string id, std::string name, std::string password)
         : User(id, name, password) {}
@@ -259,7 +299,7 @@ public:
         std::cout << "===== 管理员控制面板 =====\n";
         std::cout << "ID: " << userId << "\n";
         std::cout << "用户名: " << username << "\n";
-        std::cout << "当前余额: " << accountBalance << "\n";
+        std::cout << "当前余额: " << getAccountBalance() << "\n";
         std::cout << "状态: " << (status == UserStatus::ACTIVE ? "活跃" : "已暂停") << "\n";
         std::cout << "可用功能:\n";
         std::cout << "1. 管理用户\n";
@@ -270,23 +310,37 @@ public:
 
     // 管理员特定功能
     void manageUser(User& user, UserStatus newStatus) {
+        UserStatus oldStatus = user.getStatus();
         user.setStatus(newStatus);
         std::cout << "用户 " << user.getUsername() << " 状态已更新为 " 
                   << (newStatus == UserStatus::ACTIVE ? "活跃" : "已暂停") << std::endl;
+        if (statusListener && oldStatus != newStatus) {
+            statusListener->onUserStatusChanged(user, oldStatus);
+        }
     }
     
+    void setUserStatusListener(UserStatusListener* listener) { statusListener = listener; }
+
+    void setResourceJournal(ResourceJournal* journal) { resourceJournal = journal; }
+
+    // 设置供用户并发浏览的资源目录，管理员的资源修改会同步发布到其中；
+    // 资源状态的变更由目录通过 followStatusOf() 直接跟随资源集合
+    void setBrowseCatalog(ConcurrentResourceCollection* catalog) { browseCatalog = catalog; }
+
     // 资源管理功能
     void addResource(ResourceCollection& collection, std::shared_ptr<Resource> resource) {
+        if (collection.findResourceById(resource->getResourceId())) {
+            std::cout << "资源ID已存在: " << resource->getResourceId() << std::endl;
+            return;
+        }
         collection.addResource(resource);
+        if (browseCatalog) {
+            browseCatalog->addResource(*resource);
+        }
         std::cout << "已添加新资源: " << resource->getResourceName() << " (ID: " << resource->getResourceId() << ")" << std::endl;
         
-        // 保存更新后的资源集合到文件
-        try {
-            collection.saveToFile("resources.dat");
-            std::cout << "资源数据已保存到文件" << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "保存资源数据失败: " << e.what() << std::endl;
-        }
+        // 保存变更
+        persistResourceChange(collection, [&](ResourceJournal& journal) { journal.logAdd(*resource); });
     }
     
     void modifyResource(ResourceCollection& collection, const std::string& resourceId, 
@@ -295,38 +349,32 @@ public:
         if (resource) {
             resource->setResourceName(newName);
             resource->setHourlyRate(newRate);
+            if (browseCatalog) {
+                browseCatalog->modifyResource(resourceId, newName, newRate);
+            }
             std::cout << "资源 " << resourceId << " 已更新" << std::endl;
             
-            // 保存更新后的资源集合到文件
-            try {
-                collection.saveToFile("resources.dat");
-                std::cout << "资源数据已保存到文件" << std::endl;
-            } catch (const std::exception& e) {
-                std::cerr << "保存资源数据失败: " << e.what() << std::endl;
-            }
+            // 保存变更
+            persistResourceChange(collection, [&](ResourceJournal& journal) {
+                journal.logModify(resourceId, newName, newRate);
+            });
         } else {
             std::cout << "未找到资源 " << resourceId << std::endl;
         }
     }
     
     void deleteResource(ResourceCollection& collection, const std::string& resourceId) {
-        auto& resources = const_cast<std::vector<std::shared_ptr<Resource>>&>(collection.getAllResources());
-        for (auto it = resources.begin(); it != resources.end(); ++it) {
-            if ((*it)->getResourceId() == resourceId) {
-                resources.erase(it);
-                std::cout << "资源 " << resourceId << " 已删除" << std::endl;
-                
-                // 保存更新后的资源集合到文件
-                try {
-                    collection.saveToFile("resources.dat");
-                    std::cout << "资源数据已保存到文件" << std::endl;
-                } catch (const std::exception& e) {
-                    std::cerr << "保存资源数据失败: " << e.what() << std::endl;
-                }
-                return;
-            }
+        if (!collection.removeResource(resourceId)) {
+            std::cout << "未找到资源 " << resourceId << std::endl;
+            return;
+        }
+        if (browseCatalog) {
+            browseCatalog->removeResource(resourceId);
         }
-        std::cout << "未找到资源 " << resourceId << std::endl;
+        std::cout << "资源 " << resourceId << " 已删除" << std::endl;
+        
+        // 保存变更
+        persistResourceChange(collection, [&](ResourceJournal& journal) { journal.logRemove(resourceId); });
     }
     
     void loadResourceData(ResourceCollection& collection) {
@@ -339,20 +387,17 @@ public:
     }
     
     void setBillingRate(ResourceCollection& collection, ResourceType type, double newRate) {
-        auto resources = collection.getResourcesByType(type);
-        for (auto& resource : resources) {
-            resource->setHourlyRate(newRate);
+        collection.forEachByType(type, [newRate](Resource& resource) {
+            resource.setHourlyRate(newRate);
+        });
+        if (browseCatalog) {
+            browseCatalog->setHourlyRateByType(type, newRate);
         }
         std::cout << "已更新所有 " << (type == ResourceType::CPU ? "CPU" : "GPU") 
                   << " 资源的计费标准为 " << newRate << " 元/小时" << std::endl;
         
-        // 保存更新后的资源集合到文件
-        try {
-            collection.saveToFile("resources.dat");
-            std::cout << "资源数据已保存到文件" << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "保存资源数据失败: " << e.what() << std::endl;
-        }
+        // 保存变更
+        persistResourceChange(collection, [&](ResourceJournal& journal) { journal.logTypeRate(type, newRate); });
     }
     
     // 租赁请求管理功能
@@ -369,137 +414,484 @@ public:
 
 
 
+// 根据角色创建待反序列化的空用户对象
+inline std::shared_ptr<User> makeEmptyUser(UserRole role) {
+    switch (role) {
+        case UserRole::STUDENT: return std::make_shared<Student>();
+        case UserRole::TEACHER: return std::make_shared<Teacher>();
+        case UserRole::ADMIN: return std::make_shared<Admin>();
+        default: throw std::runtime_error("未知的用户角色");
+    }
+}
+
+// users.dat 记录布局：角色u8 状态u8 余额f64 ID 用户名 密码
+struct UserRecordTraits {
+    using Record = User;
+    static constexpr size_t kIdOffset = 1 + 1 + 8;
+    static constexpr size_t kKeyCount = 2; // 0 为用户ID，1 为用户名
+    // 一条记录的最小字节数：角色u8 状态u8 余额double 三个空字符串的长度前缀
+    static constexpr uint64_t kMinRecordSize = 1 + 1 + sizeof(double) + 3 * sizeof(uint32_t);
+
+    static const char* magic(); // UserCollection::kFileMagic，定义在集合之后
+
+    static void skip(BinaryReader& reader) {
+        reader.skip(kIdOffset);
+        reader.skip(reader.get<uint32_t>());
+        reader.skip(reader.get<uint32_t>());
+        reader.skip(reader.get<uint32_t>());
+    }
+
+    static std::string_view key(BinaryReader& reader, size_t k) {
+        reader.skip(kIdOffset);
+        if (k == 1) {
+            reader.skip(reader.get<uint32_t>());
+        }
+        uint32_t length = reader.get<uint32_t>();
+        return std::string_view(reader.position(), length);
+    }
+
+    static std::shared_ptr<User> decode(BinaryReader& reader) {
+        auto user = makeEmptyUser(static_cast<UserRole>(reader.get<uint8_t>()));
+        user->deserialize(reader);
+        return user;
+    }
+};
+
+using LazyUserFile = LazyRecordFile<UserRecordTraits>;
+
+/**
+ * @class UserIndex
+ * @brief 按键哈希分片的用户索引（字符串 -> 用户）。
+ *
+ * 每个键固定落在一个分片中，不同分片互不相关，批量加载时可由不同线程各自建立。
+ */
+class UserIndex {
+public:
+    static constexpr size_t kShardCount = 16;
+    using Shard = std::unordered_map<std::string, std::shared_ptr<User>>;
+
+private:
+    std::array<Shard, kShardCount> shards;
+
+public:
+    static size_t shardOf(const std::string& key) {
+        size_t hash = std::hash<std::string>{}(key);
+        return (hash ^ (hash >> 29)) % kShardCount;
+    }
+
+    Shard& shard(size_t index) { return shards[index]; }
+
+    std::shared_ptr<User> find(const std::string& key) const {
+        const Shard& s = shards[shardOf(key)];
+        auto it = s.find(key);
+        return it == s.end() ? nullptr : it->second;
+    }
+
+    bool contains(const std::string& key) const { return shards[shardOf(key)].count(key) != 0; }
+
+    // 键已存在时返回false
+    bool insert(const std::string& key, const std::shared_ptr<User>& user) {
+        return shards[shardOf(key)].emplace(key, user).second;
+    }
+
+    void erase(const std::string& key) { shards[shardOf(key)].erase(key); }
+
+    void clear() {
+        for (auto& s : shards) {
+            s.clear();
+        }
+    }
+
+    void reserve(size_t n) {
+        for (auto& s : shards) {
+            s.reserve(n / kShardCount + 1);
+        }
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& s : shards) {
+            total += s.size();
+        }
+        return total;
+    }
+};
+
 /**
  * @class UserCollection
  * @brief 管理系统中所有用户的集合。
  *
  * 提供添加、查找、列出用户的功能。
- * 可以按角色筛选用户。
+ * 用户按角色分区存放，按角色筛选只访问对应分区；
+ * 用户ID和用户名各有一个分片哈希索引，查找与登录为 O(1)。
+ * 用户名在集合内唯一，修改已加入集合的用户的用户名须通过 renameUser()，
+ * 直接调用 User::setUsername 会使用户名索引失效。
+ *
+ * openLazily() 以延迟模式加载：只映射文件并建立偏移索引，按ID或用户名查找（包括登录）时
+ * 才解码该用户并加入集合；第一次调用其他需要全部用户的操作时解码其余用户并退出延迟模式。
+ * 延迟模式下的查找会填充集合，不能与其他操作并发。
  */
 class UserCollection {
 private:
-    std::vector<std::shared_ptr<User>> users;
+    std::array<std::vector<std::shared_ptr<User>>, kUserRoleCount> partitions; // 按角色分区
+    UserIndex idIndex;
+    UserIndex usernameIndex;
+    size_t userCount = 0;
+
+    // 延迟模式的后备文件，为空表示全部用户都已在集合中
+    // 只有非 const 的 openLazily 能进入延迟模式，因此 const 查找中可以去掉 const 填充集合
+    std::unique_ptr<LazyUserFile> lazy;
+
+    // 延迟模式下按第k个键解码一个用户并加入集合，未找到返回nullptr
+    std::shared_ptr<User> materialize(size_t k, const std::string& key) const {
+        auto user = lazy->findByKey(k, key);
+        if (user && !idIndex.contains(user->getUserId())) {
+            const_cast<UserCollection*>(this)->insertUser(user);
+        }
+        return user;
+    }
+
+    // 解码尚未取得的全部用户并退出延迟模式
+    void materializeAll() const {
+        if (!lazy) {
+            return;
+        }
+        auto* self = const_cast<UserCollection*>(this);
+        self->reserve(lazy->size());
+        for (size_t i = 0; i < lazy->size(); ++i) {
+            if (!lazy->isMaterialized(i)) {
+                self->insertUser(lazy->at(i));
+            }
+        }
+        self->lazy.reset();
+    }
+
+    void insertUser(std::shared_ptr<User> user) {
+        if (idIndex.contains(user->getUserId())) {
+            throw std::runtime_error("用户ID已存在: " + user->getUserId());
+        }
+        if (usernameIndex.contains(user->getUsername())) {
+            throw std::runtime_error("用户名已存在: " + user->getUsername());
+        }
+        idIndex.insert(user->getUserId(), user);
+        usernameIndex.insert(user->getUsername(), user);
+        partitionOf(user->getRole()).push_back(std::move(user));
+        ++userCount;
+    }
+
+    std::vector<std::shared_ptr<User>>& partitionOf(UserRole role) {
+        return partitions[static_cast<size_t>(role)];
+    }
+    const std::vector<std::shared_ptr<User>>& partitionOf(UserRole role) const {
+        return partitions[static_cast<size_t>(role)];
+    }
 
 public:
-    // 添加用户到集合
+    // 添加用户到集合，ID或用户名重复时抛出异常
     void addUser(std::shared_ptr<User> user) {
-        users.push_back(user);
+        materializeAll();
+        insertUser(std::move(user));
     }
 
-    // 根据ID查找用户
-    std::shared_ptr<User> findUserById(const std::string& id) const {
-        for (const auto& user : users) {
-            if (user->getUserId() == id) {
-                return user;
-            }
+    // 修改用户名并更新索引，新用户名已被占用时返回false
+    bool renameUser(const std::string& id, const std::string& newName) {
+        materializeAll();
+        auto user = findUserById(id);
+        if (!user) {
+            return false;
         }
-        return nullptr; // 未找到用户
+        if (user->getUsername() == newName) {
+            return true;
+        }
+        if (usernameIndex.contains(newName)) {
+            return false;
+        }
+        usernameIndex.erase(user->getUsername());
+        user->setUsername(newName);
+        usernameIndex.insert(newName, user);
+        return true;
     }
 
-    // 获取所有用户
-    const std::vector<std::shared_ptr<User>>& getAllUsers() const {
-        return users;
+    // 清空所有用户
+    void clear() {
+        for (auto& partition : partitions) {
+            partition.clear();
+        }
+        idIndex.clear();
+        usernameIndex.clear();
+        userCount = 0;
+        lazy.reset();
     }
 
-    // 获取特定角色的用户
-    std::vector<std::shared_ptr<User>> getUsersByRole(UserRole role) const {
+    // 延迟模式加载 v2 格式文件，只建立偏移索引；verifyChecksum 为true时会读遍整个文件
+    void openLazily(const std::string& filename, bool verifyChecksum = false) {
+        auto file = std::make_unique<LazyUserFile>();
+        file->open(filename, verifyChecksum);
+        clear();
+        lazy = std::move(file);
+    }
+
+    bool isLazy() const { return lazy != nullptr; }
+
+    void reserve(size_t n) {
+        idIndex.reserve(n);
+        usernameIndex.reserve(n);
+    }
+
+    size_t size() const { return lazy ? lazy->size() : userCount; }
+
+    // 根据ID查找用户，未找到返回nullptr
+    std::shared_ptr<User> findUserById(const std::string& id) const {
+        auto user = idIndex.find(id);
+        return user || !lazy ? user : materialize(0, id);
+    }
+
+    // 根据用户名查找用户
+    std::shared_ptr<User> findUserByUsername(const std::string& name) const {
+        auto user = usernameIndex.find(name);
+        return user || !lazy ? user : materialize(1, name);
+    }
+
+    // 登录：按用户名查找并校验密码，失败返回nullptr
+    // 只检查凭据，是否允许已暂停的用户继续操作由调用方决定
+    std::shared_ptr<User> login(const std::string& name, const std::string& password) const {
+        auto user = findUserByUsername(name);
+        return user && user->verifyPassword(password) ? user : nullptr;
+    }
+
+    // 获取所有用户（按角色分区顺序：学生、教师、管理员）
+    std::vector<std::shared_ptr<User>> getAllUsers() const {
+        materializeAll();
         std::vector<std::shared_ptr<User>> result;
-        for (const auto& user : users) {
-            if (user->getRole() == role) {
-                result.push_back(user);
-            }
+        result.reserve(size());
+        for (const auto& partition : partitions) {
+            result.insert(result.end(), partition.begin(), partition.end());
         }
         return result;
     }
 
-    // 显示所有用户
-    void displayAllUsers() const {
-        std::cout << "===== 所有用户列表 =====\n";
-        for (const auto& user : users) {
-            std::cout << "ID: " << user->getUserId() << "\n";
-            std::cout << "用户名: " << user->getUsername() << "\n";
-            std::cout << "角色: ";
-            switch (user->getRole()) {
-                case UserRole::STUDENT: std::cout << "学生\n"; break;
-                case UserRole::TEACHER: std::cout << "教师\n"; break;
-                case UserRole::ADMIN: std::cout << "管理员\n"; break;
+    // 获取特定角色的用户
+    const std::vector<std::shared_ptr<User>>& getUsersByRole(UserRole role) const {
+        materializeAll();
+        return partitionOf(role);
+    }
+
+    // 遍历所有用户，回调参数为 User&
+    template <typename Visitor>
+    void forEachUser(Visitor visit) const {
+        materializeAll();
+        for (const auto& partition : partitions) {
+            for (const auto& user : partition) {
+                visit(*user);
             }
-            std::cout << "状态: " << (user->getStatus() == UserStatus::ACTIVE ? "活跃" : "已暂停") << "\n";
-            std::cout << "余额: " << user->getAccountBalance() << "\n";
-            std::cout << "------------------------\n";
         }
     }
 
+    // 按 forEachUser 的顺序遍历第 offset 个起的至多 limit 个用户，整段跳过前面的分区，用于分页
+    template <typename Visitor>
+    void forEachUserInRange(size_t offset, size_t limit, Visitor visit) const {
+        materializeAll();
+        for (const auto& partition : partitions) {
+            if (limit == 0) {
+                return;
+            }
+            if (offset >= partition.size()) {
+                offset -= partition.size();
+                continue;
+            }
+            size_t count = std::min(limit, partition.size() - offset);
+            for (size_t i = offset; i < offset + count; ++i) {
+                visit(*partition[i]);
+            }
+            limit -= count;
+            offset = 0;
+        }
+    }
+
+    // 遍历特定角色的用户，回调参数为 User&，不分配内存、不复制 shared_ptr
+    template <typename Visitor>
+    void forEachUserByRole(UserRole role, Visitor visit) const {
+        materializeAll();
+        for (const auto& user : partitionOf(role)) {
+            visit(*user);
+        }
+    }
+
+    // 统计特定角色的用户数量
+    size_t countByRole(UserRole role) const {
+        materializeAll();
+        return partitionOf(role).size();
+    }
+
+    // 显示所有用户
+    void displayAllUsers() const {
+        ReportBuffer out(size() * 128 + 64);
+        out << "===== 所有用户列表 =====\n";
+        forEachUser([&out](const User& user) {
+            appendUserDetails(out, user);
+        });
+        out.writeTo(std::cout);
+    }
+
+    // 把一个用户的详情格式化到报表缓冲区
+    static void appendUserDetails(ReportBuffer& out, const User& user) {
+        out << "ID: " << user.getUserId() << "\n";
+        out << "用户名: " << user.getUsername() << "\n";
+        out << "角色: " << UserRoleToString(user.getRole()) << "\n";
+        out << "状态: " << (user.getStatus() == UserStatus::ACTIVE ? "活跃" : "已暂停") << "\n";
+        out << "余额: " << user.getAccountBalance() << "\n";
+        out << "------------------------\n";
+    }
+
     // 持久化方法
+    // 以 v2 格式保存：所有记录先写入一块缓冲区，再整体写入文件
+    // 每 kUsersPerBlock 条记录划为一块并写入块索引，加载时可按块并行解码
+    static constexpr char kFileMagic[4] = {'C', 'U', 'S', 'R'};
+    static constexpr size_t kUsersPerBlock = 4096;
+    static constexpr uint64_t kMinRecordSize = UserRecordTraits::kMinRecordSize;
+
     void saveToFile(const std::string& filename) {
-        std::ofstream file(filename, std::ios::binary);
-        if (!file) {
-            throw std::runtime_error("无法打开文件进行写入: " + filename);
-        }
-        
-        // 写入用户数量
-        size_t count = users.size();
-        file.write(reinterpret_cast<const char*>(&count), sizeof(size_t));
-        
-        // 逐个写入用户
-        for (const auto& user : users) {
+        materializeAll();
+        BinaryWriter writer(kBinaryHeaderSize + size() * 64);
+        size_t inBlock = 0;
+        forEachUser([&writer, &inBlock](const User& user) {
             // 写入用户角色标识
-            UserRole role = user->getRole();
-            file.write(reinterpret_cast<const char*>(&role), sizeof(UserRole));
-            
-            // 根据角色序列化用户
-            user->serialize(file);
-        }
-        
-        file.close();
+            writer.put(static_cast<uint8_t>(user.getRole()));
+            user.serialize(writer);
+            if (++inBlock == kUsersPerBlock) {
+                writer.closeBlock(inBlock);
+                inBlock = 0;
+            }
+        });
+        writer.closeBlock(inBlock);
+        writer.writeToFile(filename, kFileMagic, size());
     }
     
-    void loadFromFile(const std::string& filename) {
-        std::ifstream file(filename, std::ios::binary);
-        if (!file) {
-            throw std::runtime_error("无法打开文件进行读取: " + filename);
+    // 加载 v2 格式文件，文件不是 v2 格式时按旧格式读取
+    // 文件带块索引时分三步加载（threads 为0表示按CPU核数）：
+    //   1. 各记录块并行校验、解码，并算出每个用户的ID与用户名所属的索引分片
+    //   2. 各索引分片并行建立，互不加锁
+    //   3. 按块顺序把用户放入角色分区
+    void loadFromFile(const std::string& filename, unsigned threads = 0) {
+        std::vector<char> data;
+        BinaryFileHeader header;
+        if (!readBinaryFile(filename, kFileMagic, data, header, false)) {
+            std::ifstream file(filename, std::ios::binary);
+            loadLegacy(file);
+            return;
         }
-        
+
+        std::vector<BinaryBlock> blocks;
+        if (!readBlockIndex(data.data(), header, blocks)) {
+            if (payloadChecksum(data.data() + kBinaryHeaderSize, header.payloadSize) != header.checksum) {
+                throw std::runtime_error("数据文件校验失败: " + filename);
+            }
+            blocks.push_back(BinaryBlock{0, header.payloadSize, header.recordCount, header.checksum});
+        }
+        // 记录数不在校验和覆盖范围内，预留空间之前先用各块长度约束它
+        for (const auto& block : blocks) {
+            if (block.recordCount > block.size / kMinRecordSize) {
+                throw std::runtime_error("数据文件已损坏：记录数不符");
+            }
+        }
+
+        std::vector<DecodedBlock> decoded(blocks.size());
+        parallelFor(blocks.size(), threads, [&](size_t b) {
+            decodeBlock(data.data(), blocks[b], b, decoded[b]);
+        });
+
+        // 清空当前用户
+        clear();
+        idIndex.reserve(header.recordCount);
+        usernameIndex.reserve(header.recordCount);
+        try {
+            parallelFor(UserIndex::kShardCount, threads, [&](size_t shard) {
+                for (const auto& block : decoded) {
+                    for (size_t i = 0; i < block.users.size(); ++i) {
+                        const auto& user = block.users[i];
+                        if (block.idShards[i] == shard && !idIndex.shard(shard).emplace(user->getUserId(), user).second) {
+                            throw std::runtime_error("用户ID已存在: " + user->getUserId());
+                        }
+                        if (block.nameShards[i] == shard &&
+                            !usernameIndex.shard(shard).emplace(user->getUsername(), user).second) {
+                            throw std::runtime_error("用户名已存在: " + user->getUsername());
+                        }
+                    }
+                }
+            });
+        } catch (...) {
+            clear();
+            throw;
+        }
+
+        for (auto& block : decoded) {
+            for (auto& user : block.users) {
+                partitionOf(user->getRole()).push_back(std::move(user));
+            }
+        }
+        userCount = header.recordCount;
+    }
+
+private:
+    // 一个记录块的解码结果
+    struct DecodedBlock {
+        std::vector<std::shared_ptr<User>> users;
+        std::vector<uint8_t> idShards;   // 每个用户的ID所在索引分片
+        std::vector<uint8_t> nameShards; // 每个用户的用户名所在索引分片
+    };
+
+    static void decodeBlock(const char* data, const BinaryBlock& block, size_t number, DecodedBlock& out) {
+        const char* begin = data + kBinaryHeaderSize + block.offset;
+        if (payloadChecksum(begin, block.size) != block.checksum) {
+            throw std::runtime_error("数据文件校验失败：第 " + std::to_string(number) + " 块");
+        }
+        BinaryReader reader(begin, block.size);
+        out.users.reserve(block.recordCount);
+        out.idShards.reserve(block.recordCount);
+        out.nameShards.reserve(block.recordCount);
+        for (uint64_t i = 0; i < block.recordCount; ++i) {
+            auto user = makeEmptyUser(static_cast<UserRole>(reader.get<uint8_t>()));
+            user->deserialize(reader);
+            out.idShards.push_back(static_cast<uint8_t>(UserIndex::shardOf(user->getUserId())));
+            out.nameShards.push_back(static_cast<uint8_t>(UserIndex::shardOf(user->getUsername())));
+            out.users.push_back(std::move(user));
+        }
+        if (reader.remaining() != 0) {
+            throw std::runtime_error("数据文件已损坏：第 " + std::to_string(number) + " 块记录数不符");
+        }
+    }
+
+public:
+    // 读取旧格式（size_t 数量 + 逐字段写入、'\0' 结尾字符串）
+    void loadLegacy(std::istream& file) {
         // 清空当前用户
-        users.clear();
+        clear();
         
         // 读取用户数量
         size_t count;
         file.read(reinterpret_cast<char*>(&count), sizeof(size_t));
         
         // 逐个读取用户
-        for (size_t i = 0; i < count; ++i) {
+        for (size_t i = 0; i < count && file; ++i) {
             // 读取用户角色标识
             UserRole role;
             file.read(reinterpret_cast<char*>(&role), sizeof(UserRole));
             
-            // 根据角色创建相应的用户对象
-            std::shared_ptr<User> user;
-            switch (role) {
-                case UserRole::STUDENT:
-                    user = std::make_shared<Student>();
-                    break;
-                case UserRole::TEACHER:
-                    user = std::make_shared<Teacher>();
-                    break;
-                case UserRole::ADMIN:
-                    user = std::make_shared<Admin>();
-                    break;
-                default:
-                    throw std::runtime_error("未知的用户角色");
-            }
-            
-            // 反序列化用户
+            // 根据角色创建相应的用户对象并反序列化
+            auto user = makeEmptyUser(role);
             user->deserialize(file);
             
             // 添加到集合
-            users.push_back(user);
+            addUser(user);
+        }
+        if (!file) {
+            throw std::runtime_error("旧格式用户文件已损坏");
         }
-        
-        file.close();
     }
 };
 
+inline const char* UserRecordTraits::magic() { return UserCollection::kFileMagic; }
+
 // 创建预设用户集合的辅助函数
 inline UserCollection createDefaultUserCollection() {
     UserCollection collection;